@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+namespace Stream::Bench {
+
+/**
+ * Measure the wall clock time of @p f in seconds
+ */
+double
+Time(auto&& f)
+{
+	auto const start{std::chrono::steady_clock::now()};
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Print the throughput of a case next to its baseline
+ */
+void
+Report(std::string_view name, std::size_t bytes, double seconds, double baselineSeconds);
+
+void
+Buffer(std::size_t size);
+
+void
+Text(std::size_t count);
+
+void
+Resource(std::size_t size);
+
+}//namespace Stream::Bench
@@ -0,0 +1,111 @@
+#include "Stream/Bench/Util.hpp"
+#include "Stream/Test/Util.hpp"
+#include <Stream/Buffer.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace Stream::Bench {
+
+/**
+ * Sink that discards the data
+ */
+class Null : public Output {
+
+	std::size_t
+	writeBytes(std::byte const*, std::size_t size) override
+	{ return size; }
+
+};
+
+/**
+ * Source that repeats a memory area
+ */
+class Memory : public Input {
+	std::byte const* mData;
+	std::size_t mSize;
+	std::size_t mPos{0};
+
+	std::size_t
+	readBytes(std::byte* dest, std::size_t size) override
+	{
+		size = std::min(size, mSize - mPos);
+		std::memcpy(dest, mData + mPos, size);
+		mPos = (mPos + size) % mSize;
+		return size;
+	}
+
+public:
+
+	Memory(std::byte const* data, std::size_t size) noexcept
+			: mData{data}
+			, mSize{size}
+	{}
+
+};
+
+static void
+WriteChunks(std::FILE* file, std::vector<std::byte> const& input, std::uniform_int_distribution<int> distribution)
+{
+	std::mt19937 gen(std::random_device{}());
+	for (std::size_t total{0}, r, size = input.size(); total < size; total += r) {
+		r = std::min<std::size_t>(distribution(gen), size - total);
+		std::fwrite(input.data() + total, 1, r, file);
+	}
+}
+
+static void
+ReadChunks(std::FILE* file, std::vector<std::byte>& output, std::uniform_int_distribution<int> distribution)
+{
+	std::mt19937 gen(std::random_device{}());
+	for (std::size_t total{0}, r, size = output.size(); total < size; total += r) {
+		r = std::min<std::size_t>(distribution(gen), size - total);
+		std::fread(output.data() + total, 1, r, file);
+	}
+}
+
+/**
+ * BufferOutput/BufferInput against a stdio stream with the same buffer size, in random chunks
+ */
+void
+Buffer(std::size_t size)
+{
+	auto data{Test::GetRandomBytes<std::chrono::nanoseconds>(size)};
+	std::vector<std::byte> dest(size);
+
+	for (auto [lo, hi] : {std::pair{1, 16}, {16, 256}, {256, 4096}, {4096, 65536}}) {
+		std::uniform_int_distribution<int> distribution(lo, hi);
+		auto const bufferSize{static_cast<std::size_t>(hi) * 4};
+		auto const suffix{" " + std::to_string(lo) + "-" + std::to_string(hi)};
+
+		Null null;
+		BufferOutput output(bufferSize);
+		null < output;
+		auto stream{Time([&] {
+			Test::WriteRandomChunks(output, data, distribution);
+			output << nullptr;
+		})};
+
+		auto* devNull{std::fopen("/dev/null", "w")};
+		std::setvbuf(devNull, nullptr, _IOFBF, bufferSize);
+		auto baseline{Time([&] {
+			WriteChunks(devNull, data, distribution);
+			std::fflush(devNull);
+		})};
+		std::fclose(devNull);
+		Report("BufferOutput write" + suffix, size, stream, baseline);
+
+		Memory memory{data.data(), data.size()};
+		BufferInput input(bufferSize);
+		memory > input;
+		stream = Time([&] { Test::ReadRandomChunks(input, dest, distribution); });
+
+		auto* memFile{::fmemopen(data.data(), data.size(), "r")};
+		std::setvbuf(memFile, nullptr, _IOFBF, bufferSize);
+		baseline = Time([&] { ReadChunks(memFile, dest, distribution); });
+		std::fclose(memFile);
+		Report("BufferInput read" + suffix, size, stream, baseline);
+	}
+}
+
+}//namespace Stream::Bench
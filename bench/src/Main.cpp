@@ -0,0 +1,47 @@
+#include "Stream/Bench/Util.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace Stream::Bench {
+
+void
+Report(std::string_view name, std::size_t bytes, double seconds, double baselineSeconds)
+{
+	auto const mb{static_cast<double>(bytes) / (1 << 20)};
+	std::printf("%-32.*s %10.1f MiB/s %10.1f MiB/s %7.2fx\n",
+		static_cast<int>(name.size()), name.data(),
+		mb / seconds, mb / baselineSeconds, baselineSeconds / seconds);
+}
+
+}//namespace Stream::Bench
+
+/**
+ * Stream_Bench [buffer|text|resource]... [-s MiB]
+ */
+int main(int argc, char* argv[])
+{
+	std::size_t mib{64};
+	bool buffer{argc == 1}, text{argc == 1}, resource{argc == 1};
+	for (int i{1}; i < argc; ++i) {
+		if (!std::strcmp(argv[i], "-s") && i + 1 < argc)
+			mib = std::strtoull(argv[++i], nullptr, 10);
+		else if (!std::strcmp(argv[i], "buffer"))
+			buffer = true;
+		else if (!std::strcmp(argv[i], "text"))
+			text = true;
+		else if (!std::strcmp(argv[i], "resource"))
+			resource = true;
+	}
+	if (!buffer && !text && !resource)
+		buffer = text = resource = true;
+
+	std::printf("%-32s %16s %16s %8s\n", "case", "Stream", "baseline", "ratio");
+	if (buffer)
+		Stream::Bench::Buffer(mib << 20);
+	if (text)
+		Stream::Bench::Text(mib << 14);
+	if (resource)
+		Stream::Bench::Resource(mib << 20);
+	return 0;
+}
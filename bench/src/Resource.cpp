@@ -0,0 +1,165 @@
+#include "Stream/Bench/Util.hpp"
+#include "Stream/Test/Util.hpp"
+#include <Stream/Buffer.hpp>
+#include <Stream/Pipe.hpp>
+#include <Stream/Socket.hpp>
+#include <Stream/UringFile.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace Stream::Bench {
+
+static constexpr std::size_t Chunk{1 << 16};
+
+/**
+ * Throw the error of a failed system call, so that a baseline is not timed on a broken setup
+ */
+static int
+Check(int result)
+{
+	if (result == -1)
+		throw std::system_error{errno, std::generic_category()};
+	return result;
+}
+
+static void
+WriteAll(Output& output, std::vector<std::byte> const& data)
+{
+	BufferOutput buffer(Chunk);
+	output < buffer;
+	for (std::size_t total{0}; total < data.size(); total += Chunk)
+		buffer.write(data.data() + total, std::min(Chunk, data.size() - total));
+	buffer << nullptr;
+}
+
+static void
+ReadAll(Input& input, std::vector<std::byte>& data)
+{
+	BufferInput buffer(Chunk);
+	input > buffer;
+	for (std::size_t total{0}; total < data.size(); total += Chunk)
+		buffer.read(data.data() + total, std::min(Chunk, data.size() - total));
+}
+
+static void
+WriteAll(std::FILE* file, std::vector<std::byte> const& data)
+{
+	std::setvbuf(file, nullptr, _IOFBF, Chunk);
+	for (std::size_t total{0}; total < data.size(); total += Chunk)
+		std::fwrite(data.data() + total, 1, std::min(Chunk, data.size() - total), file);
+	std::fflush(file);
+}
+
+static void
+ReadAll(std::FILE* file, std::vector<std::byte>& data)
+{
+	std::setvbuf(file, nullptr, _IOFBF, Chunk);
+	for (std::size_t total{0}; total < data.size(); total += Chunk)
+		std::fread(data.data() + total, 1, std::min(Chunk, data.size() - total), file);
+}
+
+/**
+ * File, UringFile, Pipe and loopback Socket throughput against stdio streams on the same kind of descriptor
+ */
+void
+Resource(std::size_t size)
+{
+	auto data{Test::GetRandomBytes<std::chrono::nanoseconds>(size)};
+	std::vector<std::byte> dest(size);
+	auto const path{(std::filesystem::temp_directory_path() / "Stream_Bench").string()};
+
+	auto baseline{Time([&] {
+		auto* file{std::fopen(path.c_str(), "w")};
+		WriteAll(file, data);
+		::fsync(::fileno(file));
+		std::fclose(file);
+	})};
+	auto stream{Time([&] {
+		File file(path, File::Mode::W);
+		WriteAll(file, data);
+		file << nullptr;
+	})};
+	Report("File write", size, stream, baseline);
+	stream = Time([&] {
+		UringFile file(path, File::Mode::W);
+		WriteAll(file, data);
+		file << nullptr;
+	});
+	Report("UringFile write", size, stream, baseline);
+
+	baseline = Time([&] {
+		auto* file{std::fopen(path.c_str(), "r")};
+		ReadAll(file, dest);
+		std::fclose(file);
+	});
+	stream = Time([&] {
+		File file(path, File::Mode::R);
+		ReadAll(file, dest);
+	});
+	Report("File read", size, stream, baseline);
+	stream = Time([&] {
+		UringFile file(path, File::Mode::R);
+		ReadAll(file, dest);
+	});
+	Report("UringFile read", size, stream, baseline);
+	std::filesystem::remove(path);
+
+	stream = Time([&] {
+		Pipe pipe;
+		std::jthread writer{[&] { WriteAll(pipe, data); }};
+		ReadAll(pipe, dest);
+	});
+	baseline = Time([&] {
+		int fd[2];
+		Check(::pipe(fd));
+		auto* in{::fdopen(fd[0], "r")};
+		auto* out{::fdopen(fd[1], "w")};
+		std::jthread writer{[&] { WriteAll(out, data); }};
+		ReadAll(in, dest);
+		writer.join();
+		std::fclose(in);
+		std::fclose(out);
+	});
+	Report("Pipe", size, stream, baseline);
+
+	Socket server(Socket::Address::Inet{"127.0.0.1", 0}, 1);
+	auto const port{server.getPort()};
+	if (!port)
+		throw std::system_error{port.error()};
+	Socket::Address::Inet const address{"127.0.0.1", *port};
+	stream = Time([&] {
+		Socket client(address);
+		std::jthread writer{[&] { WriteAll(client, data); }};
+		auto connection{server.accept()};
+		ReadAll(*connection, dest);
+	});
+	int const listener{Check(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))};
+	sockaddr_in bound{};
+	::socklen_t length{sizeof bound};
+	bound.sin_family = AF_INET;
+	bound.sin_addr.s_addr = ::htonl(INADDR_LOOPBACK);
+	Check(::bind(listener, reinterpret_cast<sockaddr*>(&bound), sizeof bound));
+	Check(::listen(listener, 1));
+	Check(::getsockname(listener, reinterpret_cast<sockaddr*>(&bound), &length));
+	baseline = Time([&] {
+		int const client{Check(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP))};
+		Check(::connect(client, reinterpret_cast<sockaddr const*>(&bound), sizeof bound));
+		auto* out{::fdopen(client, "w")};
+		std::jthread writer{[&] {
+			WriteAll(out, data);
+			std::fclose(out);
+		}};
+		auto* in{::fdopen(Check(::accept(listener, nullptr, nullptr)), "r")};
+		ReadAll(in, dest);
+		std::fclose(in);
+	});
+	::close(listener);
+	Report("Socket loopback", size, stream, baseline);
+}
+
+}//namespace Stream::Bench
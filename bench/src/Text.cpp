@@ -0,0 +1,100 @@
+#include "Stream/Bench/Util.hpp"
+#include <Stream/Text.hpp>
+#include <concepts>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace Stream::Bench {
+
+/**
+ * Parse @p count values of @p text with TextInput and with std::istringstream
+ */
+template <typename T>
+static void
+Parse(std::string_view name, std::string const& text, std::size_t count)
+{
+	// integers are summed with wraparound, a signed overflow would be undefined
+	using Sum = std::conditional_t<std::integral<T>, std::uint64_t, T>;
+	Sum sum{};
+	auto stream{Time([&] {
+		BufferInput buffer(text.data(), text.size());
+		TextInput input;
+		buffer > input;
+		T t;
+		char separator;
+		for (std::size_t i{0}; i < count; ++i) {
+			input >> t >> separator;
+			sum += static_cast<Sum>(t);
+		}
+	})};
+
+	Sum baselineSum{};
+	auto baseline{Time([&] {
+		std::istringstream input{text};
+		T t;
+		for (std::size_t i{0}; i < count; ++i) {
+			input >> t;
+			baselineSum += static_cast<Sum>(t);
+		}
+	})};
+
+	if (sum != baselineSum)
+		std::printf("%.*s mismatch\n", static_cast<int>(name.size()), name.data());
+	Report(name, text.size(), stream, baseline);
+}
+
+/**
+ * TextInput integer, float and line parsing against std::istringstream
+ */
+void
+Text(std::size_t count)
+{
+	std::mt19937_64 gen(std::random_device{}());
+
+	std::string integers;
+	std::uniform_int_distribution<std::int64_t> integer(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max());
+	for (std::size_t i{0}; i < count; ++i)
+		integers.append(std::to_string(integer(gen) >> (i % 64))).push_back(' ');
+	Parse<std::int64_t>("TextInput int64", integers, count);
+
+	std::string floats;
+	std::uniform_real_distribution<double> real(-1e6, 1e6);
+	char buff[32];
+	for (std::size_t i{0}; i < count; ++i) {
+		auto r{std::to_chars(buff, buff + sizeof buff, real(gen))};
+		floats.append(buff, r.ptr).push_back(' ');
+	}
+	Parse<double>("TextInput double", floats, count);
+
+	std::string lines;
+	for (std::size_t i{0}; i < count; ++i)
+		lines.append("line ").append(std::to_string(i)).append(i % 7, '.').push_back('\n');
+
+	std::size_t length{0};
+	auto stream{Time([&] {
+		BufferInput buffer(lines.data(), lines.size());
+		TextInput input;
+		buffer > input;
+		for (std::size_t i{0}; i < count; ++i)
+			length += input.getLine().size();
+	})};
+
+	std::size_t baselineLength{0};
+	auto baseline{Time([&] {
+		std::istringstream input{lines};
+		std::string line;
+		for (std::size_t i{0}; i < count; ++i) {
+			std::getline(input, line);
+			baselineLength += line.size();
+		}
+	})};
+
+	if (length != baselineLength)
+		std::printf("TextInput getLine mismatch\n");
+	Report("TextInput getLine", lines.size(), stream, baseline);
+}
+
+}//namespace Stream::Bench
@@ -1,47 +1,153 @@
 #pragma once
 
 #include "InOut.hpp"
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 
 
 namespace Stream {
 
+/**
+ * Returns buffer memory to the memory resource it is allocated from
+ * @class	BufferDeleter Buffer.hpp "Stream/Buffer.hpp"
+ */
+struct BufferDeleter {
+	std::pmr::memory_resource* resource{std::pmr::get_default_resource()};
+	std::size_t size{0};
+	std::size_t alignment{alignof(std::max_align_t)};
+
+	void
+	operator()(std::byte* buffer) const noexcept
+	{ resource->deallocate(buffer, size, alignment); }
+
+};//struct Stream::BufferDeleter
+
+
+/**
+ * How a buffer grows when a request exceeds its capacity and when it gives the memory back
+ * @class	BufferPolicy Buffer.hpp "Stream/Buffer.hpp"
+ */
+struct BufferPolicy {
+	double growthFactor{2}; ///< Capacity is multiplied by this until the request fits
+	std::size_t maxSize{SIZE_MAX}; ///< Largest capacity, larger requests fail with BadAllocation
+	std::size_t highWaterMark{0}; ///< Capacity above which the buffer shrinks back to this size once the data fits again, 0 to never shrink
+	bool releaseEmpty{false}; ///< Give the memory back to the resource once the buffer is empty, and borrow it again when data arrives. An input buffer does so when it is asked for more data, so that the views into the consumed data stay valid until then
+	std::size_t alignment{0}; ///< Block size that the memory is aligned to and the capacity and the transfers are rounded to, 0 for none
+
+	/**
+	 * Round @p size up to a multiple of alignment
+	 */
+	[[nodiscard]]
+	std::size_t
+	align(std::size_t size) const noexcept;
+
+	/**
+	 * Get the capacity to grow to from @p capacity for @p size bytes
+	 * @return		0 if @p size exceeds maxSize
+	 */
+	[[nodiscard]]
+	std::size_t
+	grow(std::size_t capacity, std::size_t size) const noexcept;
+
+	/**
+	 * Whether a buffer of @p capacity should shrink when it needs @p size bytes
+	 */
+	[[nodiscard]]
+	bool
+	shrinks(std::size_t capacity, std::size_t size) const noexcept;
+
+};//struct Stream::BufferPolicy
+
+
 /**
  * Input stream buffer
  * @class	BufferInput Buffer.hpp "Stream/Buffer.hpp"
  */
 class BufferInput : public Input {
+	friend class StageAccess;
+
 protected:
 
-	std::unique_ptr<std::byte[]> mInputBuffer;
+	std::unique_ptr<std::byte[], BufferDeleter> mInputBuffer;
 	std::size_t mInputBufferSize{0};
 	std::byte const* mInputDataBeg{nullptr};
 	std::byte* mInputDataEnd{nullptr};
 	std::byte const* mInputEnd{nullptr};
+	BufferPolicy mInputPolicy;
 
 	BufferInput() noexcept = default;
 
 	std::size_t
 	readBytes(std::byte* dest, std::size_t size) override;
 
+	std::size_t
+	readVector(std::span<::iovec const> iov) override;
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) override;
+
 	/**
 	 * @param[in]	size
 	 * @pre			@p size must be non-zero
 	 * @throws		Input::Exception
+	 * @details		Final, so that a stream overriding it fails to compile instead of being bypassed by the non-throwing
+	 *				calls, tryProvideBytes() is the one to override.
 	 */
 	virtual std::size_t
-	provideBytes(std::size_t size);
+	provideBytes(std::size_t size) final;
+
+	/**
+	 * Non-throwing counterpart of provideBytes()
+	 * @param[in]	size
+	 * @pre			@p size must be non-zero
+	 */
+	virtual std::expected<std::size_t, std::error_code>
+	tryProvideBytes(std::size_t size);
+
+	/**
+	 * Make room for @p size bytes of data by shifting, growing or shrinking the buffer
+	 * @param[in]	size
+	 * @return		false if the buffer could not be grown
+	 */
+	bool
+	prepareInput(std::size_t size) noexcept;
+
+	/**
+	 * Give the memory back to the resource, keeping the capacity to borrow again
+	 * @pre			The buffer must be empty
+	 */
+	void
+	releaseInput() noexcept;
+
+	/**
+	 * Fill the drained buffer of BufferPolicy::releaseEmpty, waiting for the source without holding the memory
+	 * @param[in]	size
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryProvideReleased(std::size_t size);
+
+	/**
+	 * Move the data into a new buffer of @p size bytes, allocated as the policy requires
+	 * @param[in]	size
+	 * @param[in]	skew Offset of the data in the new buffer, keeps the end of the data aligned
+	 * @return		false if the buffer could not be allocated
+	 */
+	bool
+	reallocInput(std::size_t size, std::size_t skew) noexcept;
 
 public:
 
 	/**
 	 * Construct with an initial buffer size
 	 * @param[in]	initialBufferSize Number of bytes to allocate for input buffer
+	 * @param[in]	resource Memory resource that the buffer and its growths are allocated from
 	 * @pre			@p initialBufferSize must be non-zero
+	 * @pre			@p resource must outlive the buffer
 	 * @throws		std::bad_alloc
 	 */
 	explicit
-	BufferInput(std::size_t initialBufferSize);
+	BufferInput(std::size_t initialBufferSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 	BufferInput(void const* sourceBuff, std::size_t sourceSize) noexcept;
 
@@ -74,6 +180,27 @@ public:
 	std::size_t
 	provide(std::size_t size);
 
+	/**
+	 * Non-throwing counterpart of provideSomeMore()
+	 * @param[in]	size
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryProvideSomeMore(std::size_t size);
+
+	/**
+	 * Non-throwing counterpart of provideSome()
+	 * @param[in]	size
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryProvideSome(std::size_t size);
+
+	/**
+	 * Non-throwing counterpart of provide()
+	 * @param[in]	size
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryProvide(std::size_t size);
+
 	void
 	consumed(std::size_t size) noexcept;
 
@@ -84,6 +211,32 @@ public:
 	std::byte const&
 	operator[](int i) const noexcept;
 
+	/**
+	 * Get the memory resource that the buffer grows from
+	 */
+	[[nodiscard]]
+	std::pmr::memory_resource*
+	getInputResource() const noexcept;
+
+	/**
+	 * Set how the buffer grows and shrinks
+	 * @param[in]	policy
+	 * @details		A buffer that does not meet the alignment of @p policy is reallocated, a failure keeps it as it is.
+	 */
+	void
+	setInputPolicy(BufferPolicy const& policy) noexcept;
+
+	[[nodiscard]]
+	BufferPolicy const&
+	getInputPolicy() const noexcept;
+
+	/**
+	 * Get the number of bytes the buffer can hold.
+	 */
+	[[nodiscard]]
+	std::size_t
+	getInputCapacity() const noexcept;
+
 	[[nodiscard]]
 	std::byte const*
 	begin() const noexcept;
@@ -100,35 +253,82 @@ public:
  * @class	BufferOutput Buffer.hpp "Stream/Buffer.hpp"
  */
 class BufferOutput : public Output {
+	friend class StageAccess;
+
 protected:
 
-	std::unique_ptr<std::byte[]> mOutputBuffer;
+	std::unique_ptr<std::byte[], BufferDeleter> mOutputBuffer;
 	std::size_t mOutputBufferSize{0};
 	std::byte const* mOutputDataBeg{nullptr};
 	std::byte* mOutputDataEnd{nullptr};
 	std::byte const* mOutputEnd{nullptr};
+	BufferPolicy mOutputPolicy;
 
 	BufferOutput() noexcept = default;
 
 	std::size_t
 	writeBytes(std::byte const* src, std::size_t size) override;
 
+	std::size_t
+	writeVector(std::span<::iovec const> iov) override;
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) override;
+
 	void
 	flush() override;
 
+	/**
+	 * @param[in]	size
+	 * @throws		Output::Exception
+	 * @details		Final, so that a stream overriding it fails to compile instead of being bypassed by the non-throwing
+	 *				calls, tryAllocBytes() is the one to override.
+	 */
 	virtual std::size_t
-	allocBytes(std::size_t size);
+	allocBytes(std::size_t size) final;
+
+	/**
+	 * Non-throwing counterpart of allocBytes()
+	 * @param[in]	size
+	 */
+	virtual std::expected<std::size_t, std::error_code>
+	tryAllocBytes(std::size_t size);
+
+	/**
+	 * Make room for @p size bytes of space by shifting, growing or shrinking the buffer
+	 * @param[in]	size
+	 * @return		false if the buffer could not be grown
+	 */
+	bool
+	prepareOutput(std::size_t size) noexcept;
+
+	/**
+	 * Give the memory back to the resource, keeping the capacity to borrow again
+	 * @pre			The buffer must be empty
+	 */
+	void
+	releaseOutput() noexcept;
+
+	/**
+	 * Move the data into a new buffer of @p size bytes, allocated as the policy requires
+	 * @param[in]	size
+	 * @return		false if the buffer could not be allocated
+	 */
+	bool
+	reallocOutput(std::size_t size) noexcept;
 
 public:
 
 	/**
 	 * Construct with an initial buffer size
 	 * @param[in]	initialBufferSize Number of bytes to allocate for output buffer
+	 * @param[in]	resource Memory resource that the buffer and its growths are allocated from
 	 * @pre			@p initialBufferSize must be non-zero
+	 * @pre			@p resource must outlive the buffer
 	 * @throws		std::bad_alloc
 	 */
 	explicit
-	BufferOutput(std::size_t initialBufferSize);
+	BufferOutput(std::size_t initialBufferSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 	BufferOutput(void* sinkBuff, std::size_t sinkSize) noexcept;
 
@@ -163,6 +363,27 @@ public:
 	std::size_t
 	alloc(std::size_t size);
 
+	/**
+	 * Non-throwing counterpart of allocSomeMore()
+	 * @param[in]	size
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryAllocSomeMore(std::size_t size);
+
+	/**
+	 * Non-throwing counterpart of allocSome()
+	 * @param[in]	size
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryAllocSome(std::size_t size);
+
+	/**
+	 * Non-throwing counterpart of alloc()
+	 * @param[in]	size
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryAlloc(std::size_t size);
+
 	void
 	produced(std::size_t size) noexcept;
 
@@ -170,6 +391,32 @@ public:
 	std::size_t
 	getSpaceSize() const noexcept;
 
+	/**
+	 * Get the memory resource that the buffer grows from
+	 */
+	[[nodiscard]]
+	std::pmr::memory_resource*
+	getOutputResource() const noexcept;
+
+	/**
+	 * Set how the buffer grows and shrinks
+	 * @param[in]	policy
+	 * @details		A buffer that does not meet the alignment of @p policy is reallocated, a failure keeps it as it is.
+	 */
+	void
+	setOutputPolicy(BufferPolicy const& policy) noexcept;
+
+	[[nodiscard]]
+	BufferPolicy const&
+	getOutputPolicy() const noexcept;
+
+	/**
+	 * Get the number of bytes the buffer can hold.
+	 */
+	[[nodiscard]]
+	std::size_t
+	getOutputCapacity() const noexcept;
+
 	[[nodiscard]]
 	std::byte*
 	begin() noexcept;
@@ -194,13 +441,13 @@ public:
 	};//struct Stream::Buffer::Exception
 
 	explicit
-	Buffer(std::size_t buffInitialSize);
+	Buffer(std::size_t buffInitialSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-	Buffer(std::size_t inBuffInitialSize, std::size_t outBuffInitialSize);
+	Buffer(std::size_t inBuffInitialSize, std::size_t outBuffInitialSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-	Buffer(std::size_t inBuffInitialSize, void* sinkBuff, std::size_t sinkSize);
+	Buffer(std::size_t inBuffInitialSize, void* sinkBuff, std::size_t sinkSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-	Buffer(void const* sourceBuff, std::size_t sourceSize, std::size_t outBuffInitialSize);
+	Buffer(void const* sourceBuff, std::size_t sourceSize, std::size_t outBuffInitialSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 	Buffer(void const* sourceBuff, std::size_t sourceSize, void* sinkBuff, std::size_t sinkSize) noexcept;
 
@@ -215,6 +462,7 @@ public:
  * @class	BufferReader Buffer.hpp "Stream/Buffer.hpp"
  */
 class BufferReader : public Input {
+	friend class StageAccess;
 	static BufferInput* Unreadable;
 
 protected:
@@ -224,6 +472,12 @@ protected:
 	std::size_t
 	readBytes(std::byte* dest, std::size_t size) override;
 
+	std::size_t
+	readVector(std::span<::iovec const> iov) override;
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) override;
+
 	BufferInput&
 	getSource() noexcept;
 
@@ -264,6 +518,7 @@ public:
  * @class	BufferWriter Buffer.hpp "Stream/Buffer.hpp"
  */
  class BufferWriter : public Output {
+	friend class StageAccess;
 	static BufferOutput* Unwritable;
 
 protected:
@@ -273,6 +528,12 @@ protected:
 	std::size_t
 	writeBytes(std::byte const* src, std::size_t size) override;
 
+	std::size_t
+	writeVector(std::span<::iovec const> iov) override;
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) override;
+
 	BufferOutput&
 	getSink() noexcept;
 
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+
+namespace Stream {
+
+/**
+ * Memory resource handing out power of two size class blocks from per thread caches
+ * @class	BufferPool BufferPool.hpp "Stream/BufferPool.hpp"
+ * @details	Meant to be shared by many buffers with BufferPolicy::releaseEmpty set, so that idle buffers hold no
+ *			memory and a busy thread keeps reusing the blocks of the buffers it has drained.
+ *			Requests outside [MinClassSize, MaxClassSize] or with extended alignment go to the upstream resource.
+ *			The caches of a pool are keyed by an id that is never reused, so a pool constructed at the address of a
+ *			destroyed one starts with empty caches. The blocks that other threads still cache for a destroyed pool go
+ *			back to its upstream resource when those threads exit, so the upstream must outlive them.
+ */
+class BufferPool : public std::pmr::memory_resource {
+	std::pmr::memory_resource* mUpstream;
+	std::size_t mCacheSize;
+	std::uint64_t mId; // key of the thread caches
+
+	void*
+	do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+	void
+	do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+
+	bool
+	do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+
+public:
+
+	static constexpr std::size_t MinClassSize{std::size_t{1} << 12};
+	static constexpr std::size_t MaxClassSize{std::size_t{1} << 22};
+
+	/**
+	 * Construct a pool
+	 * @param[in]	cacheSize Number of free blocks a thread keeps per size class before giving them to @p upstream
+	 * @param[in]	upstream Memory resource that the blocks are allocated from
+	 */
+	explicit
+	BufferPool(std::size_t cacheSize = 64, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept;
+
+	BufferPool(BufferPool const&) = delete;
+
+	/**
+	 * Give the blocks cached by the calling thread to the upstream resource
+	 * @details		The caches of the other threads are no longer used by any pool.
+	 */
+	~BufferPool();
+
+	/**
+	 * Get the size of the block that a request of @p size bytes is served from
+	 * @return		0 if @p size is not pooled
+	 */
+	[[nodiscard]]
+	static std::size_t
+	GetClassSize(std::size_t size) noexcept;
+
+	/**
+	 * Get the number of bytes cached by the calling thread
+	 */
+	[[nodiscard]]
+	std::size_t
+	getCachedSize() const noexcept;
+
+	/**
+	 * Give the blocks cached by the calling thread to the upstream resource
+	 */
+	void
+	trim() noexcept;
+
+};//class Stream::BufferPool
+
+}//namespace Stream
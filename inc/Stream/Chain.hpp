@@ -0,0 +1,215 @@
+#pragma once
+
+#include "Stream/Buffer.hpp"
+#include <tuple>
+
+
+namespace Stream {
+
+/**
+ * Stream stages linked at compile time
+ * @class	Chain Chain.hpp "Stream/Chain.hpp"
+ * @tparam	Stages Stage types ordered from the outermost source/sink to the innermost input/output,
+ *			e.g. Chain<File, BufferInput, TextInput>
+ * @details	Owns the stages and links each adjacent pair with <b>operator></b> and/or <b>operator<</b> as
+ *			the runtime chains do. BufferInput, BufferOutput, BufferReader and BufferWriter stages that do not
+ *			customize their hops are replaced with a subclass calling the adjacent stage through its static type,
+ *			so the compiler can inline across the stages without the indirect calls.
+ *			A stage that is relinked at runtime falls back to the virtual calls.
+ */
+template <typename ... Stages>
+class Chain {
+	static_assert(sizeof...(Stages) > 0);
+
+	template <typename T, typename S>
+	class BufferInputLink;
+
+	template <typename T, typename S>
+	class BufferReaderLink;
+
+	template <typename T, typename S>
+	class BufferOutputLink;
+
+	template <typename T, typename S>
+	class BufferWriterLink;
+
+	template <typename T, typename S>
+	static constexpr bool IsBufferInputHop{
+		Source<S> && std::derived_from<T, BufferInput> &&
+		StageAccess::InheritsTryProvideBytes<T, BufferInput>};
+
+	template <typename T, typename S>
+	static constexpr bool IsBufferReaderHop{
+		std::derived_from<S, BufferInput> && std::derived_from<T, BufferReader> &&
+		StageAccess::InheritsReadBytes<T, BufferReader>};
+
+	template <typename T, typename S>
+	static constexpr bool IsBufferOutputHop{
+		Sink<S> && std::derived_from<T, BufferOutput> &&
+		StageAccess::InheritsTryAllocBytes<T, BufferOutput>};
+
+	template <typename T, typename S>
+	static constexpr bool IsBufferWriterHop{
+		std::derived_from<S, BufferOutput> && std::derived_from<T, BufferWriter> &&
+		StageAccess::InheritsWriteBytes<T, BufferWriter>};
+
+	template <typename T, typename S>
+	using InputStage =
+		std::conditional_t<IsBufferInputHop<T, S>, BufferInputLink<T, S>,
+		std::conditional_t<IsBufferReaderHop<T, S>, BufferReaderLink<T, S>,
+		T>>;
+
+	template <typename T, typename S>
+	using Stage =
+		std::conditional_t<IsBufferOutputHop<T, S>, BufferOutputLink<InputStage<T, S>, S>,
+		std::conditional_t<IsBufferWriterHop<T, S>, BufferWriterLink<InputStage<T, S>, S>,
+		InputStage<T, S>>>;
+
+	template <typename Done, typename ... Rest>
+	struct Build;
+
+	using Types = typename Build<std::tuple<>, Stages ...>::type;
+
+	template <std::size_t I, typename T>
+	struct Node;
+
+	template <typename Indices>
+	struct Storage;
+
+	Storage<std::make_index_sequence<sizeof...(Stages)>> mStages;
+
+	template <typename S, typename T>
+	static void
+	Connect(S& s, T& t) noexcept;
+
+	template <std::size_t ... I>
+	void
+	connect(std::index_sequence<I ...>) noexcept;
+
+	template <typename S>
+	static std::size_t
+	ReadSome(S& source, std::byte* dest, std::size_t size);
+
+	template <typename S>
+	static std::expected<std::size_t, std::error_code>
+	TryReadSome(S& source, std::byte* dest, std::size_t size);
+
+	template <typename S>
+	static std::size_t
+	WriteSome(S& sink, std::byte const* src, std::size_t size);
+
+	template <typename S>
+	static std::expected<std::size_t, std::error_code>
+	TryWriteSome(S& sink, std::byte const* src, std::size_t size);
+
+public:
+
+	/**
+	 * Actual type of the stage at @p I
+	 */
+	template <std::size_t I>
+	using StageType = std::tuple_element_t<I, Types>;
+
+	using Front = StageType<0>;
+
+	using Back = StageType<sizeof...(Stages) - 1>;
+
+	/**
+	 * Construct the stages and link them
+	 * @param[in]	args One tuple of constructor arguments for each stage
+	 */
+	template <typename ... Args>
+	explicit
+	Chain(Args&& ... args)
+	requires (sizeof...(Args) == sizeof...(Stages));
+
+	Chain(Chain const&) = delete;
+
+	Chain&
+	operator=(Chain const&) = delete;
+
+	/**
+	 * Get the stage at @p I
+	 */
+	template <std::size_t I>
+	StageType<I>&
+	get() noexcept;
+
+	/**
+	 * Get the outermost source/sink
+	 */
+	Front&
+	front() noexcept;
+
+	/**
+	 * Get the innermost input/output
+	 */
+	Back&
+	back() noexcept;
+
+	/**
+	 * Read @p size bytes into @p dest from the innermost input
+	 * @param[out]	dest Memory address where the data to be read will be written
+	 * @param[in]	size Number of bytes to be read
+	 * @return		Self-reference
+	 * @throws		Input::Exception
+	 */
+	Chain&
+	read(void* dest, std::size_t size)
+	requires Source<Back>;
+
+	/**
+	 * Read @p size bytes into @p dest from the innermost input
+	 * @param[out]	dest Memory address where the data to be read will be written
+	 * @param[in]	size Number of bytes to be read
+	 * @return		Number of bytes that can actually be read
+	 * @throws		Input::Exception
+	 */
+	std::size_t
+	readSome(void* dest, std::size_t size)
+	requires Source<Back>;
+
+	/**
+	 * Write @p size bytes from @p src to the innermost output
+	 * @param[in]	src Memory address where the data to be written will be read
+	 * @param[in]	size Number of bytes to be written
+	 * @return		Self-reference
+	 * @throws		Output::Exception
+	 */
+	Chain&
+	write(void const* src, std::size_t size)
+	requires Sink<Back>;
+
+	/**
+	 * Write @p size bytes from @p src to the innermost output
+	 * @param[in]	src Memory address where the data to be written will be read
+	 * @param[in]	size Number of bytes to be written
+	 * @return		Number of bytes that can actually be written
+	 * @throws		Output::Exception
+	 */
+	std::size_t
+	writeSome(void const* src, std::size_t size)
+	requires Sink<Back>;
+
+	/**
+	 * Extract @p t from the innermost input
+	 * @details	Trivially copyable objects that the innermost input reads as raw bytes are read without virtual calls.
+	 */
+	Chain&
+	operator>>(auto& t)
+	requires Source<Back>;
+
+	/**
+	 * Insert @p t into the innermost output
+	 * @details	Trivially copyable objects that the innermost output writes as raw bytes are written without virtual calls.
+	 */
+	Chain&
+	operator<<(auto const& t)
+	requires Sink<Back>;
+
+};//class Stream::Chain
+
+}//namespace Stream
+
+
+#include "../../src/Chain.tpp"
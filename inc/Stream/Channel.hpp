@@ -0,0 +1,106 @@
+#pragma once
+
+#include "InOut.hpp"
+#include <atomic>
+#include <memory>
+
+
+namespace Stream {
+
+/**
+ * In-process byte channel between a single writer thread and a single reader thread
+ * @class	Channel Channel.hpp "Stream/Channel.hpp"
+ * @details	Backed by a lock-free ring, so a transfer is a single copy into and out of the ring without system
+ *			calls. A side that finds the ring empty or full spins briefly and then sleeps in Poll() on an eventfd
+ *			until the other side makes progress, so the wait can be interrupted. The other side only writes the
+ *			eventfd when a sleeper has announced itself.
+ *			The writer ends the stream with closeOutput(), after which the reader gets the remaining data and then
+ *			no_message_available. After closeInput(), writing fails with broken_pipe once the ring is full.
+ */
+class Channel : public Input, public Output {
+	friend class StageAccess;
+
+	static constexpr std::size_t Closed{std::size_t{1} << (sizeof(std::size_t) * 8 - 1)};
+
+	std::unique_ptr<std::byte[]> mRing;
+	std::size_t mMask;
+
+	int mReadable; // eventfd the reader sleeps on
+	int mWritable; // eventfd the writer sleeps on
+
+	alignas(64) std::atomic<std::size_t> mHead{0}; // read position, Closed bit set by the reader
+	std::size_t mCachedTail{0}; // last tail seen by the reader
+	std::atomic<bool> mReaderSleeping{false};
+
+	alignas(64) std::atomic<std::size_t> mTail{0}; // write position, Closed bit set by the writer
+	std::size_t mCachedHead{0}; // last head seen by the writer
+	std::atomic<bool> mWriterSleeping{false};
+
+	std::size_t
+	readBytes(std::byte* dest, std::size_t size) final;
+
+	std::size_t
+	writeBytes(std::byte const* src, std::size_t size) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) final;
+
+	std::error_code
+	waitReadable(unsigned attempt) noexcept final;
+
+	std::error_code
+	waitWritable(unsigned attempt) noexcept final;
+
+	/**
+	 * Sleep on @p descriptor unless @p ready after announcing it through @p sleeping
+	 */
+	static std::error_code
+	Sleep(int descriptor, std::atomic<bool>& sleeping, auto&& ready) noexcept;
+
+	/**
+	 * Wake up the other side if it sleeps on @p descriptor
+	 */
+	static void
+	Wake(int descriptor, std::atomic<bool> const& sleeping) noexcept;
+
+public:
+
+	/**
+	 * Construct a channel
+	 * @param[in]	capacity Size of the ring, rounded up to a power of two
+	 * @pre			@p capacity must be non-zero
+	 * @throws		std::bad_alloc
+	 * @throws		std::system_error
+	 */
+	explicit
+	Channel(std::size_t capacity = 64 * 1024);
+
+	Channel(Channel const&) = delete;
+
+	~Channel();
+
+	/**
+	 * End the stream, the reader gets no_message_available once it has read the remaining data
+	 */
+	void
+	closeOutput() noexcept;
+
+	/**
+	 * Stop reading, the writer gets broken_pipe
+	 */
+	void
+	closeInput() noexcept;
+
+	/**
+	 * Get the size of the ring.
+	 */
+	[[nodiscard]]
+	std::size_t
+	getCapacity() const noexcept;
+
+};//class Stream::Channel
+
+}//namespace Stream
@@ -13,18 +13,48 @@ namespace Stream {
  * @class	File File.hpp "Stream/File.hpp"
  */
 class File : public Input, public Output {
+	friend class StageAccess;
+
+	friend std::size_t
+	Transfer(Input& input, Output& output, std::size_t size);
 
 	int mDescriptor;
+	int mBufferedDescriptor{-1}; // same file without O_DIRECT, opened for the first unaligned part of a direct transfer
 
 	explicit
 	File(int descriptor) noexcept;
 
+	/**
+	 * Get the descriptor for the unaligned head or tail of a direct transfer, opening it the first time
+	 * @return		-1 with errno set, to EINVAL if this file is not direct
+	 */
+	int
+	getBufferedDescriptor() noexcept;
+
 	std::size_t
 	readBytes(std::byte* dest, std::size_t size) final;
 
 	std::size_t
 	writeBytes(std::byte const* src, std::size_t size) final;
 
+	std::size_t
+	readVector(std::span<::iovec const> iov) final;
+
+	std::size_t
+	writeVector(std::span<::iovec const> iov) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) final;
+
+	std::error_code
+	waitReadable(unsigned attempt) noexcept final;
+
+	std::error_code
+	waitWritable(unsigned attempt) noexcept final;
+
 	void
 	flush() final;
 
@@ -46,11 +76,20 @@ public:
 		AR = O_RDWR | O_CREAT | O_APPEND
 	};//enum class Stream::File::Mode
 
+	/**
+	 * File caching modes
+	 * @class	Caching File.hpp "Stream/File.hpp"
+	 */
+	enum class Caching : int {
+		Buffered = 0, ///< Through the page cache
+		Direct = O_DIRECT ///< Bypassing the page cache, transfers should be aligned to getBlockSize()
+	};//enum class Stream::File::Caching
+
 	/**
 	 * Construct a %File resource.
 	 * @throws	File::Exception
 	 */
-	File(std::string const& name, Mode mode);
+	File(std::string const& name, Mode mode, Caching caching = Caching::Buffered);
 
 	File(File const&) = delete;
 
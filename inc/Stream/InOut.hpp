@@ -1,7 +1,13 @@
 #pragma once
 
+#include "Stats.hpp"
+#include <atomic>
+#include <chrono>
+#include <expected>
+#include <span>
 #include <system_error>
 #include <type_traits>
+#include <sys/uio.h>
 
 
 namespace Stream {
@@ -78,14 +84,125 @@ public:
 };//class Stream::Exception
 
 
+template <typename ... Stages>
+class Chain;
+
+class StageAccess;
+
+
+/**
+ * Wait strategy of the stages that have no descriptor to wait on
+ * @class	Backoff InOut.hpp "Stream/InOut.hpp"
+ * @details	The first @ref spins retries only pause the CPU, the next @ref yields retries yield the thread and
+ *			the rest sleep starting from @ref minSleep, doubling up to @ref maxSleep.
+ */
+struct Backoff {
+	unsigned spins{16};
+	unsigned yields{16};
+	std::chrono::microseconds minSleep{50};
+	std::chrono::microseconds maxSleep{10'000};
+
+	/**
+	 * Wait before the retry number @p attempt
+	 */
+	void
+	operator()(unsigned attempt) const noexcept;
+
+};//struct Stream::Backoff
+
+
+/**
+ * Backoff used by the default wait strategy of Input and Output
+ * @details	A stage that needs another one overrides waitReadable()/waitWritable() with its own Backoff.
+ */
+inline constexpr Backoff DefaultBackoff{};
+
+
+/**
+ * Wakeup of the waits of a thread
+ * @class	Interrupt InOut.hpp "Stream/InOut.hpp"
+ * @details	Once triggered, Poll() and the default wait strategy of Input and Output fail with
+ *			std::errc::operation_canceled instead of waiting on the threads that installed it. A read or write that
+ *			blocks in the kernel is not interrupted, a blocking descriptor needs a timeout for that.
+ */
+class Interrupt {
+	int mDescriptor; // eventfd
+	std::atomic<bool> mTriggered{false};
+
+	friend std::error_code
+	Poll(int descriptor, short events) noexcept;
+
+public:
+
+	/**
+	 * @throws		std::system_error
+	 */
+	Interrupt();
+
+	Interrupt(Interrupt const&) = delete;
+
+	~Interrupt();
+
+	/**
+	 * Wake up the waits of the threads that installed this interrupt, and cancel their next ones
+	 */
+	void
+	trigger() noexcept;
+
+	/**
+	 * Install @p interrupt for the waits of the calling thread, nullptr to remove it
+	 * @pre			@p interrupt must outlive the installation
+	 */
+	static void
+	Install(Interrupt const* interrupt) noexcept;
+
+	/**
+	 * Check the interrupt installed for the calling thread
+	 * @return		std::errc::operation_canceled if it is triggered
+	 */
+	[[nodiscard]]
+	static std::error_code
+	Check() noexcept;
+
+};//class Stream::Interrupt
+
+
+/**
+ * Wait until @p descriptor is ready for @p events
+ * @param[in]	descriptor File descriptor
+ * @param[in]	events <b>poll()</b> events such as POLLIN or POLLOUT
+ * @return		Error code if waiting failed, or std::errc::operation_canceled if the Interrupt of the thread is triggered
+ */
+std::error_code
+Poll(int descriptor, short events) noexcept;
+
+
+/**
+ * Check whether @p descriptor is in non-blocking mode
+ * @details		EAGAIN from a blocking descriptor means that its SO_RCVTIMEO/SO_SNDTIMEO timeout expired, which is
+ *				an error rather than a reason to wait. errno is preserved.
+ */
+[[nodiscard]]
+bool
+IsNonBlocking(int descriptor) noexcept;
+
+
 /**
  * %Input stream base class
  * @class	Input InOut.hpp "Stream/InOut.hpp"
  */
 class Input {
+	friend class StageAccess;
 	static Input* Unreadable;
 
 	Input* mSource;
+	[[no_unique_address]] Probe mProbe;
+
+	std::size_t
+	readAvailable(std::byte* dest, std::size_t size);
+
+	std::size_t
+	readVectorAvailable(std::span<::iovec const> iov);
 
 protected:
 
@@ -106,6 +223,38 @@ protected:
 	virtual std::size_t
 	readBytes(std::byte* dest, std::size_t size) = 0;
 
+	/**
+	 * Read into the memory areas of @p iov in order
+	 * @param[in]	iov Memory areas where the data to be read will be written
+	 * @return		Number of bytes that can actually be read. 0 to signal for retry.
+	 * @pre			@p iov must contain at least one non-empty area
+	 * @throws		Input::Exception
+	 * @details		Default implementation reads into the first non-empty area only.
+	 */
+	virtual std::size_t
+	readVector(std::span<::iovec const> iov);
+
+	/**
+	 * Read @p size bytes into @p dest without throwing Input::Exception
+	 * @param[out]	dest Memory address where the data to be read will be written
+	 * @param[in]	size Number of bytes to be read
+	 * @return		Number of bytes that can actually be read. 0 to signal for retry.
+	 * @pre			@p dest must be a valid memory area
+	 * @pre			@p size must be non-zero
+	 * @details		Default implementation catches the Input::Exception thrown by readBytes().
+	 */
+	virtual std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size);
+
+	/**
+	 * Wait until reading can make progress after readBytes(), readVector() or tryReadBytes() signaled for retry
+	 * @param[in]	attempt Number of consecutive retries before this one
+	 * @return		Error code if waiting failed
+	 * @details		Default implementation waits for the linked source, or uses DefaultBackoff if there is none.
+	 */
+	virtual std::error_code
+	waitReadable(unsigned attempt) noexcept;
+
 	/**
 	 * Finalize the ongoing process and read any remaining data
 	 */
@@ -115,8 +264,27 @@ protected:
 	Input&
 	getSource() noexcept;
 
+	/**
+	 * Call tryReadBytes() of @p source once, for the stages that read from other sources
+	 */
+	static std::expected<std::size_t, std::error_code>
+	TryReadBytes(Input& source, std::byte* dest, std::size_t size);
+
+	/**
+	 * Call waitReadable() of @p source after it signaled for retry, for the stages that read from other sources
+	 */
+	static std::error_code
+	WaitReadable(Input& source, unsigned attempt) noexcept;
+
 public:
 
+	/**
+	 * Get the instrumentation of this input
+	 * @details		Records nothing unless the library is built with <b>STREAM_INSTRUMENTATION</b>.
+	 */
+	Probe&
+	getInputProbe() noexcept;
+
 	/**
 	 * Input exception
 	 * @class	Exception InOut.hpp "Stream/InOut.hpp"
@@ -124,6 +292,7 @@ public:
 	class Exception : public std::system_error {
 
 		friend class Input;
+		friend class StageAccess;
 		void* mDest;
 		std::size_t mSize;
 
@@ -213,6 +382,47 @@ public:
 	std::size_t
 	readSome(void* dest, std::size_t size);
 
+	/**
+	 * Read into the memory areas of @p iov in order
+	 * @param[in]	iov Memory areas where the data to be read will be written
+	 * @return		Self-reference
+	 * @pre			Memory areas of @p iov must be valid
+	 * @throws		Input::Exception
+	 */
+	Input&
+	read(std::span<::iovec const> iov);
+
+	/**
+	 * Read @p size bytes into @p dest without throwing Input::Exception
+	 * @param[out]	dest Memory address where the data to be read will be written
+	 * @param[in]	size Number of bytes to be read
+	 * @return		Number of bytes that can actually be read, less than @p size only if an error occurred after
+	 *				some of the data is read. Error code if nothing could be read.
+	 * @pre			@p dest must be a valid memory area
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryRead(void* dest, std::size_t size);
+
+	/**
+	 * Read @p size bytes into @p dest without throwing Input::Exception
+	 * @param[out]	dest Memory address where the data to be read will be written
+	 * @param[in]	size Number of bytes to be read
+	 * @return		Number of bytes that can actually be read or error code
+	 * @pre			@p dest must be a valid memory area
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryReadSome(void* dest, std::size_t size);
+
+	/**
+	 * Read into the memory areas of @p iov in order
+	 * @param[in]	iov Memory areas where the data to be read will be written
+	 * @return		Number of bytes that can actually be read
+	 * @pre			Memory areas of @p iov must be valid
+	 * @throws		Input::Exception
+	 */
+	std::size_t
+	readSome(std::span<::iovec const> iov);
+
 	/**
 	 * Read into trivially copyable @p t
 	 * @param[out]	t
@@ -254,9 +464,17 @@ extern Input& StdIn;
  * @class	Output InOut.hpp "Stream/InOut.hpp"
  */
 class Output {
+	friend class StageAccess;
 	static Output* Unwritable;
 
 	Output* mSink;
+	[[no_unique_address]] Probe mProbe;
+
+	std::size_t
+	writeAvailable(std::byte const* src, std::size_t size);
+
+	std::size_t
+	writeVectorAvailable(std::span<::iovec const> iov);
 
 protected:
 
@@ -269,7 +487,7 @@ protected:
 	 * Write @p size bytes from @p src
 	 * @param[in]	src Memory address where the data to be written will be read
 	 * @param[in]	size Number of bytes to be written
-	 * @return		Number of bytes that can actually be written
+	 * @return		Number of bytes that can actually be written. 0 to signal for retry.
 	 * @pre			@p src must be a valid memory area
 	 * @pre			@p size must be non-zero
 	 * @throws		Output::Exception
@@ -277,6 +495,38 @@ protected:
 	virtual std::size_t
 	writeBytes(std::byte const* src, std::size_t size) = 0;
 
+	/**
+	 * Write the memory areas of @p iov in order
+	 * @param[in]	iov Memory areas where the data to be written will be read
+	 * @return		Number of bytes that can actually be written. 0 to signal for retry.
+	 * @pre			@p iov must contain at least one non-empty area
+	 * @throws		Output::Exception
+	 * @details		Default implementation writes the first non-empty area only.
+	 */
+	virtual std::size_t
+	writeVector(std::span<::iovec const> iov);
+
+	/**
+	 * Write @p size bytes from @p src without throwing Output::Exception
+	 * @param[in]	src Memory address where the data to be written will be read
+	 * @param[in]	size Number of bytes to be written
+	 * @return		Number of bytes that can actually be written. 0 to signal for retry.
+	 * @pre			@p src must be a valid memory area
+	 * @pre			@p size must be non-zero
+	 * @details		Default implementation catches the Output::Exception thrown by writeBytes().
+	 */
+	virtual std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size);
+
+	/**
+	 * Wait until writing can make progress after writeBytes(), writeVector() or tryWriteBytes() signaled for retry
+	 * @param[in]	attempt Number of consecutive retries before this one
+	 * @return		Error code if waiting failed
+	 * @details		Default implementation waits for the linked sink, or uses DefaultBackoff if there is none.
+	 */
+	virtual std::error_code
+	waitWritable(unsigned attempt) noexcept;
+
 	/**
 	 * Finalize the ongoing process and write any remaining data
 	 */
@@ -286,8 +536,36 @@ protected:
 	Output&
 	getSink() noexcept;
 
+	/**
+	 * Call writeBytes() of @p sink, for the stages that pass the data on to other sinks
+	 * @throws		Output::Exception
+	 */
+	static std::size_t
+	WriteBytes(Output& sink, std::byte const* src, std::size_t size);
+
+	/**
+	 * Call writeVector() of @p sink, for the stages that pass the data on to other sinks
+	 * @throws		Output::Exception
+	 */
+	static std::size_t
+	WriteVector(Output& sink, std::span<::iovec const> iov);
+
+	/**
+	 * Write to @p sink at least one of @p size bytes from @p src, waiting for it as needed
+	 * @throws		Output::Exception
+	 */
+	static std::size_t
+	WriteAvailable(Output& sink, std::byte const* src, std::size_t size);
+
 public:
 
+	/**
+	 * Get the instrumentation of this output
+	 * @details		Records nothing unless the library is built with <b>STREAM_INSTRUMENTATION</b>.
+	 */
+	Probe&
+	getOutputProbe() noexcept;
+
 	/**
 	 * Output exception
 	 * @class	Exception InOut.hpp "Stream/InOut.hpp"
@@ -295,6 +573,7 @@ public:
 	class Exception : public std::system_error {
 
 		friend class Output;
+		friend class StageAccess;
 		void const* mSrc;
 		std::size_t mSize;
 
@@ -384,6 +663,47 @@ public:
 	std::size_t
 	writeSome(void const* src, std::size_t size);
 
+	/**
+	 * Write the memory areas of @p iov in order
+	 * @param[in]	iov Memory areas where the data to be written will be read
+	 * @return		Self-reference
+	 * @pre			Memory areas of @p iov must be valid
+	 * @throws		Output::Exception
+	 */
+	Output&
+	write(std::span<::iovec const> iov);
+
+	/**
+	 * Write @p size bytes from @p src without throwing Output::Exception
+	 * @param[in]	src Memory address where the data to be written will be read
+	 * @param[in]	size Number of bytes to be written
+	 * @return		Number of bytes that can actually be written, less than @p size only if an error occurred after
+	 *				some of the data is written. Error code if nothing could be written.
+	 * @pre			@p src must be a valid memory area
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryWrite(void const* src, std::size_t size);
+
+	/**
+	 * Write @p size bytes from @p src without throwing Output::Exception
+	 * @param[in]	src Memory address where the data to be written will be read
+	 * @param[in]	size Number of bytes to be written
+	 * @return		Number of bytes that can actually be written or error code
+	 * @pre			@p src must be a valid memory area
+	 */
+	std::expected<std::size_t, std::error_code>
+	tryWriteSome(void const* src, std::size_t size);
+
+	/**
+	 * Write the memory areas of @p iov in order
+	 * @param[in]	iov Memory areas where the data to be written will be read
+	 * @return		Number of bytes that can actually be written
+	 * @pre			Memory areas of @p iov must be valid
+	 * @throws		Output::Exception
+	 */
+	std::size_t
+	writeSome(std::span<::iovec const> iov);
+
 	/**
 	 * Write trivially copyable @p t
 	 * @param[in]	t
@@ -420,6 +740,66 @@ extern Output& StdOut;
 extern Output& StdErr;
 
 
+/**
+ * Access of Chain to the hooks of its stages
+ * @class	StageAccess InOut.hpp "Stream/InOut.hpp"
+ * @details	The stages befriend this class instead of Chain, so Chain reaches the hooks through the static type of a
+ *			stage and nothing else of it.
+ */
+class StageAccess {
+	template <typename ...> friend class Chain;
+
+	template <typename T, typename Base>
+	static constexpr bool InheritsTryProvideBytes{
+		requires { requires std::same_as<decltype(&T::tryProvideBytes), decltype(&Base::tryProvideBytes)>; }};
+
+	template <typename T, typename Base>
+	static constexpr bool InheritsReadBytes{
+		requires { requires std::same_as<decltype(&T::readBytes), decltype(&Base::readBytes)>; } &&
+		requires { requires std::same_as<decltype(&T::tryReadBytes), decltype(&Base::tryReadBytes)>; }};
+
+	template <typename T, typename Base>
+	static constexpr bool InheritsTryAllocBytes{
+		requires { requires std::same_as<decltype(&T::tryAllocBytes), decltype(&Base::tryAllocBytes)>; }};
+
+	template <typename T, typename Base>
+	static constexpr bool InheritsWriteBytes{
+		requires { requires std::same_as<decltype(&T::writeBytes), decltype(&Base::writeBytes)>; } &&
+		requires { requires std::same_as<decltype(&T::tryWriteBytes), decltype(&Base::tryWriteBytes)>; }};
+
+	template <typename S>
+	static std::size_t
+	ReadBytes(S& source, std::byte* dest, std::size_t size);
+
+	template <typename S>
+	static std::expected<std::size_t, std::error_code>
+	TryReadBytes(S& source, std::byte* dest, std::size_t size);
+
+	template <typename S>
+	static std::error_code
+	WaitReadable(S& source, unsigned attempt) noexcept;
+
+	template <typename S>
+	static std::size_t
+	WriteBytes(S& sink, std::byte const* src, std::size_t size);
+
+	template <typename S>
+	static std::expected<std::size_t, std::error_code>
+	TryWriteBytes(S& sink, std::byte const* src, std::size_t size);
+
+	template <typename S>
+	static std::error_code
+	WaitWritable(S& sink, unsigned attempt) noexcept;
+
+	static void
+	SetUnread(Input::Exception& exc, void* dest, std::size_t size) noexcept;
+
+	static void
+	SetUnwritten(Output::Exception& exc, void const* src, std::size_t size) noexcept;
+
+};//class Stream::StageAccess
+
+
 std::error_code
 make_error_code(Exception::Code e) noexcept;
 
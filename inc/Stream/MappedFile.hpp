@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include <string>
+#include <sys/types.h>
+
+
+namespace Stream {
+
+/**
+ * Read-only file presented as a buffer through a memory mapping
+ * @class	MappedFile MappedFile.hpp "Stream/MappedFile.hpp"
+ * @details	The data is read straight out of the page cache through begin()/end()/getDataSize(), without copying
+ *			it into a buffer. The whole file is mapped at once, or a window that slides forward as it is consumed
+ *			for files that are too large to map at once. The mapping is advised for sequential access and the
+ *			window is prefetched.
+ */
+class MappedFile : public BufferInput {
+
+	int mDescriptor{-1};
+	std::byte* mMap{nullptr};
+	std::size_t mMapSize{0};
+	::off_t mMapOffset{0}; // file offset of mMap
+	::off_t mFileSize{0};
+	std::size_t mWindowSize{0};
+
+	std::expected<std::size_t, std::error_code>
+	tryProvideBytes(std::size_t size) override;
+
+	/**
+	 * Map the window that starts at the page of @p offset and holds at least @p size bytes
+	 */
+	std::error_code
+	map(::off_t offset, std::size_t size) noexcept;
+
+	void
+	release() noexcept;
+
+public:
+
+	struct Exception : std::system_error
+	{ using std::system_error::system_error; };
+
+	/**
+	 * Map a file for reading
+	 * @param[in]	name Path of the file
+	 * @param[in]	windowSize Size of the sliding window, 0 to map the whole file
+	 * @throws		MappedFile::Exception
+	 */
+	explicit
+	MappedFile(std::string const& name, std::size_t windowSize = 0);
+
+	MappedFile(MappedFile const&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept;
+
+	friend void
+	swap(MappedFile& a, MappedFile& b) noexcept;
+
+	MappedFile&
+	operator=(MappedFile&& other) noexcept;
+
+	~MappedFile();
+
+	/**
+	 * Get the total size of the file.
+	 */
+	[[nodiscard]]
+	::off_t
+	getFileSize() const noexcept;
+
+};//class Stream::MappedFile
+
+
+/**
+ * Output file written through a memory mapping
+ * @class	MappedFileOutput MappedFile.hpp "Stream/MappedFile.hpp"
+ * @details	The data is produced straight into the page cache through begin()/end()/alloc(), without write system
+ *			calls or copying it out of a buffer. Allocating beyond the mapping grows the file with fallocate() and
+ *			extends the mapping as the output policy grows a buffer. Flushing synchronizes the range produced since
+ *			the previous flush with msync(), and closing trims the file to the produced size.
+ */
+class MappedFileOutput : public BufferOutput {
+
+	int mDescriptor{-1};
+	std::byte* mMap{nullptr};
+	std::size_t mMapSize{0};
+
+	std::expected<std::size_t, std::error_code>
+	tryAllocBytes(std::size_t size) override;
+
+	void
+	flush() override;
+
+	/**
+	 * Grow the file and the mapping to @p size bytes
+	 */
+	std::error_code
+	grow(std::size_t size) noexcept;
+
+public:
+
+	struct Exception : std::system_error
+	{ using std::system_error::system_error; };
+
+	/**
+	 * Create or truncate a file for writing
+	 * @param[in]	name Path of the file
+	 * @param[in]	initialSize Number of bytes to reserve in the file and map at first
+	 * @pre			@p initialSize must be non-zero
+	 * @throws		MappedFileOutput::Exception
+	 */
+	explicit
+	MappedFileOutput(std::string const& name, std::size_t initialSize = 1024 * 1024);
+
+	MappedFileOutput(MappedFileOutput const&) = delete;
+
+	MappedFileOutput(MappedFileOutput&& other) noexcept;
+
+	friend void
+	swap(MappedFileOutput& a, MappedFileOutput& b) noexcept;
+
+	MappedFileOutput&
+	operator=(MappedFileOutput&& other) noexcept;
+
+	~MappedFileOutput();
+
+	/**
+	 * Synchronize the data, unmap and trim the file to the produced size
+	 * @throws		Output::Exception
+	 */
+	void
+	close();
+
+	/**
+	 * Get the number of bytes produced into the file.
+	 */
+	[[nodiscard]]
+	std::size_t
+	getFileSize() const noexcept;
+
+};//class Stream::MappedFileOutput
+
+}//namespace Stream
@@ -11,6 +11,10 @@ namespace Stream {
  * @class	Pipe Pipe.hpp "Stream/Pipe.hpp"
  */
 class Pipe : public Input, public Output {
+	friend class StageAccess;
+
+	friend std::size_t
+	Transfer(Input& input, Output& output, std::size_t size);
 
 	union {
 		int mDescriptors[2];
@@ -26,6 +30,24 @@ class Pipe : public Input, public Output {
 	std::size_t
 	writeBytes(std::byte const* src, std::size_t size) final;
 
+	std::size_t
+	readVector(std::span<::iovec const> iov) final;
+
+	std::size_t
+	writeVector(std::span<::iovec const> iov) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) final;
+
+	std::error_code
+	waitReadable(unsigned attempt) noexcept final;
+
+	std::error_code
+	waitWritable(unsigned attempt) noexcept final;
+
 public:
 
 	struct Exception : std::system_error
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Stream {
+
+/**
+ * Input stream buffer that reads ahead of the consumer on a background thread
+ * @class	ReadAheadInput ReadAhead.hpp "Stream/ReadAhead.hpp"
+ * @details	A thread started by the first request fills blocks from the source while the consumer works on the
+ *			block it holds, so reading overlaps parsing. The held block is presented through begin()/end() without
+ *			copying and is swapped for the next filled one once it is empty. Only a request for data that crosses
+ *			the end of the held block copies the tail of the block and the start of the next one aside.
+ *			The source is read by the thread only, it must not be used by others until the buffer is destroyed.
+ *			Destroying the buffer interrupts the thread while it waits for the source through Poll() or the default
+ *			wait strategy. A read that blocks in the kernel is completed first, so a blocking descriptor should have a
+ *			timeout.
+ */
+class ReadAheadInput : public BufferInput {
+
+	struct Block {
+		std::unique_ptr<std::byte[]> mData;
+		std::size_t mSize{0}; // filled
+		std::error_code mError; // of the read that ended the block, the stream ends after it
+	};
+
+	std::size_t mBlockSize;
+	std::vector<Block> mBlocks;
+	std::size_t mFilled{0}; // blocks filled by the thread
+	std::size_t mTaken{0}; // blocks taken by the consumer
+	std::size_t mReleased{0}; // blocks given back by the consumer
+	bool mStopped{false};
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	Interrupt mInterrupt; // of the waits of the thread for the source
+	std::jthread mThread;
+
+	std::size_t mHeldOffset{0}; // part of the held block not presented yet
+	bool mSpilling{false}; // the data is presented from mSpill
+	std::vector<std::byte> mSpill; // data crossing the end of the held block
+	std::error_code mError; // ends the stream once the held block is consumed
+
+	std::expected<std::size_t, std::error_code>
+	tryProvideBytes(std::size_t size) override;
+
+	/**
+	 * Fill the blocks until stopped or the source ends
+	 */
+	void
+	run() noexcept;
+
+	/**
+	 * Give the held block back and take the next one, waiting for the thread to fill it
+	 * @return		false if the stream has ended
+	 */
+	bool
+	swapBlock() noexcept;
+
+	/**
+	 * Get the held block.
+	 */
+	Block&
+	getHeld() noexcept;
+
+	/**
+	 * Append up to @p size bytes of the held block to the spilled data
+	 */
+	void
+	spill(std::size_t size);
+
+public:
+
+	/**
+	 * Construct with the block size and the number of blocks
+	 * @param[in]	blockSize Number of bytes the thread reads into a block
+	 * @param[in]	depth Number of blocks, including the one held by the consumer, 2 for double buffering
+	 * @pre			@p blockSize must be non-zero
+	 * @pre			@p depth must be at least 2
+	 * @throws		std::bad_alloc
+	 * @throws		std::system_error
+	 */
+	explicit
+	ReadAheadInput(std::size_t blockSize = 64 * 1024, std::size_t depth = 2);
+
+	ReadAheadInput(ReadAheadInput const&) = delete;
+
+	/**
+	 * Stop the thread, interrupting its wait for the source
+	 */
+	~ReadAheadInput();
+
+	/**
+	 * Get the number of blocks.
+	 */
+	[[nodiscard]]
+	std::size_t
+	getDepth() const noexcept;
+
+};//class Stream::ReadAheadInput
+
+}//namespace Stream
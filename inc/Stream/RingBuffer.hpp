@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Buffer.hpp"
+
+
+namespace Stream {
+
+/**
+ * Input stream buffer that wraps around instead of shifting the unconsumed data
+ * @class	RingBufferInput RingBuffer.hpp "Stream/RingBuffer.hpp"
+ * @details	The storage is a memfd mapped twice back to back, so the data stays contiguous in virtual memory
+ *			across the wrap-around and begin()/end() keep working. The data is only copied when a request
+ *			larger than the capacity grows the ring.
+ */
+class RingBufferInput : public BufferInput {
+
+	std::byte* mRing{nullptr}; // first of the two mappings
+	std::size_t mRingSize{0}; // size of a single mapping
+
+	std::expected<std::size_t, std::error_code>
+	tryProvideBytes(std::size_t size) override;
+
+	/**
+	 * Rebase the data into the first mapping and make @p size bytes of room
+	 * @return		false if the ring could not be grown
+	 */
+	bool
+	prepareRing(std::size_t size) noexcept;
+
+	/**
+	 * Map a ring of @p size bytes twice
+	 * @return		Address of the first mapping, nullptr on failure with errno set
+	 * @pre			@p size must be a multiple of the page size
+	 */
+	static std::byte*
+	Map(std::size_t size) noexcept;
+
+	static std::size_t
+	RoundToPage(std::size_t size) noexcept;
+
+public:
+
+	struct Exception : std::system_error
+	{ using std::system_error::system_error; };
+
+	/**
+	 * Construct with an initial capacity
+	 * @param[in]	initialBufferSize Capacity, rounded up to a multiple of the page size
+	 * @pre			@p initialBufferSize must be non-zero
+	 * @throws		RingBufferInput::Exception
+	 */
+	explicit
+	RingBufferInput(std::size_t initialBufferSize);
+
+	RingBufferInput(RingBufferInput const&) = delete;
+
+	RingBufferInput(RingBufferInput&& other) noexcept;
+
+	friend void
+	swap(RingBufferInput& a, RingBufferInput& b) noexcept;
+
+	RingBufferInput&
+	operator=(RingBufferInput&& other) noexcept;
+
+	~RingBufferInput();
+
+};//class Stream::RingBufferInput
+
+}//namespace Stream
@@ -0,0 +1,31 @@
+#pragma once
+
+
+namespace Stream {
+
+/**
+ * Find the first occurrence of @p c
+ * @param[in]	beg Start of the memory area
+ * @param[in]	end End of the memory area
+ * @param[in]	c Character to find
+ * @return		Position of @p c, @p end if there is none
+ * @details		Compares 32 characters per step with AVX2 when the CPU supports it, 16 with SSE2 otherwise, and one
+ *				at a time on other architectures.
+ */
+char const*
+FindByte(char const* beg, char const* end, char c) noexcept;
+
+/**
+ * Skip the digits of @p base
+ * @param[in]	beg Start of the memory area
+ * @param[in]	end End of the memory area
+ * @param[in]	base Base of the digits, the letters are case insensitive digits above 9
+ * @return		Position of the first character that is not a digit, @p end if there is none
+ * @pre			@p base must be in [2, 36]
+ * @details		Classifies the characters as many at a time as FindByte() compares them, with unsigned range
+ *				checks of the digits and of the letters.
+ */
+char const*
+SkipDigits(char const* beg, char const* end, unsigned base) noexcept;
+
+}//namespace Stream
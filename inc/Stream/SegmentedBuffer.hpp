@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include <vector>
+
+
+namespace Stream {
+
+/**
+ * Output stream buffer made of a chain of segments
+ * @class	SegmentedBufferOutput SegmentedBuffer.hpp "Stream/SegmentedBuffer.hpp"
+ * @details	Growing appends a segment instead of moving the data into a larger buffer, and flushing writes all of
+ *			the segments to the sink with vectored writes. The space returned by alloc() is contiguous within the
+ *			current segment. The segments are kept for reuse after a flush.
+ */
+class SegmentedBufferOutput : public Output {
+	friend class StageAccess;
+
+	struct Segment {
+		std::unique_ptr<std::byte[], BufferDeleter> mData;
+		std::size_t mSize; // capacity
+		std::size_t mBeg{0}; // written to the sink
+		std::size_t mEnd{0}; // produced
+	};
+
+	std::vector<Segment> mSegments;
+	std::size_t mCurrent{0}; // segment being produced into
+	std::size_t mSegmentSize;
+	std::pmr::memory_resource* mResource;
+
+	std::size_t
+	writeBytes(std::byte const* src, std::size_t size) override;
+
+	void
+	flush() override;
+
+	/**
+	 * Move on to a segment that has at least @p size bytes of space
+	 * @throws		Output::Exception
+	 */
+	void
+	advance(std::size_t size);
+
+	/**
+	 * Discard the first @p size bytes of data, which are written to the sink
+	 */
+	void
+	consume(std::size_t size) noexcept;
+
+public:
+
+	/**
+	 * Construct with a segment size
+	 * @param[in]	segmentSize Size of a segment, larger allocations get a segment of their own
+	 * @param[in]	resource Memory resource that the segments are allocated from
+	 * @pre			@p segmentSize must be non-zero
+	 * @pre			@p resource must outlive the buffer
+	 * @throws		std::bad_alloc
+	 */
+	explicit
+	SegmentedBufferOutput(std::size_t segmentSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+	SegmentedBufferOutput(SegmentedBufferOutput&& other) noexcept;
+
+	friend void
+	swap(SegmentedBufferOutput& a, SegmentedBufferOutput& b) noexcept;
+
+	SegmentedBufferOutput&
+	operator=(SegmentedBufferOutput&& other) noexcept;
+
+	virtual ~SegmentedBufferOutput();
+
+	/**
+	 * Get contiguous space for at most @p size bytes, appending a segment if the current one is full
+	 * @param[in]	size
+	 * @return		Number of bytes of space at begin()
+	 * @throws		Output::Exception
+	 */
+	std::size_t
+	allocSome(std::size_t size);
+
+	/**
+	 * Get contiguous space for @p size bytes, appending a segment if the current one does not have enough
+	 * @param[in]	size
+	 * @return		@p size
+	 * @throws		Output::Exception
+	 */
+	std::size_t
+	alloc(std::size_t size);
+
+	void
+	produced(std::size_t size) noexcept;
+
+	/**
+	 * Get the space left in the current segment
+	 */
+	[[nodiscard]]
+	std::size_t
+	getSpaceSize() const noexcept;
+
+	/**
+	 * Get the size of the data that is not written to the sink yet
+	 */
+	[[nodiscard]]
+	std::size_t
+	getDataSize() const noexcept;
+
+	[[nodiscard]]
+	std::size_t
+	getSegmentCount() const noexcept;
+
+	[[nodiscard]]
+	std::byte*
+	begin() noexcept;
+
+	[[nodiscard]]
+	std::byte const*
+	end() const noexcept;
+
+};//class Stream::SegmentedBufferOutput
+
+}//namespace Stream
@@ -13,6 +13,10 @@ namespace Stream {
  * @class	Socket Socket.hpp "Stream/Socket.hpp"
  */
 class Socket : public Input, public Output {
+	friend class StageAccess;
+
+	friend std::size_t
+	Transfer(Input& input, Output& output, std::size_t size);
 
 	int mDescriptor;
 
@@ -25,6 +29,24 @@ class Socket : public Input, public Output {
 	std::size_t
 	writeBytes(std::byte const* src, std::size_t size) final;
 
+	std::size_t
+	readVector(std::span<::iovec const> iov) final;
+
+	std::size_t
+	writeVector(std::span<::iovec const> iov) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) final;
+
+	std::error_code
+	waitReadable(unsigned attempt) noexcept final;
+
+	std::error_code
+	waitWritable(unsigned attempt) noexcept final;
+
 public:
 
 	struct Exception : std::system_error
@@ -113,6 +135,14 @@ public:
 	std::expected<int, std::error_code>
 	getMSS() const noexcept;
 
+	/**
+	 * Get the local port of this Socket, e.g. the one assigned when bound to port 0.
+	 * @return	Port in host byte order
+	 */
+	[[nodiscard]]
+	std::expected<std::uint16_t, std::error_code>
+	getPort() const noexcept;
+
 	[[nodiscard]]
 	std::expected<::timeval, std::error_code>
 	getRecvTimeout() const noexcept;
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace Stream {
+
+/**
+ * Whether the library is built with <b>STREAM_INSTRUMENTATION</b>
+ */
+#if defined(STREAM_INSTRUMENTATION)
+inline constexpr bool Instrumented{true};
+#else
+inline constexpr bool Instrumented{false};
+#endif
+
+
+/**
+ * Latency histogram with power of two nanosecond buckets
+ * @class	Histogram Stats.hpp "Stream/Stats.hpp"
+ * @details	Bucket @p i counts the samples in [2<sup>i-1</sup>, 2<sup>i</sup>) nanoseconds.
+ */
+struct Histogram {
+	static constexpr std::size_t Size{40};
+
+	std::array<std::uint64_t, Size> buckets{};
+
+	void
+	record(std::chrono::nanoseconds latency) noexcept
+	{ ++buckets[std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(latency.count())), Size - 1)]; }
+
+	/**
+	 * Get the total number of samples
+	 */
+	[[nodiscard]]
+	std::uint64_t
+	getCount() const noexcept;
+
+	/**
+	 * Get the upper bound of the bucket that contains the @p p th percentile
+	 * @param[in]	p Percentile in [0, 1]
+	 */
+	[[nodiscard]]
+	std::chrono::nanoseconds
+	getPercentile(double p) const noexcept;
+
+};//struct Stream::Histogram
+
+
+/**
+ * Counters of a single stage
+ * @class	Stats Stats.hpp "Stream/Stats.hpp"
+ */
+struct Stats {
+	std::uint64_t calls{0}; ///< readBytes/writeBytes calls including the ones that signaled for retry
+	std::uint64_t bytes{0}; ///< Bytes transferred by those calls
+	std::uint64_t syscalls{0}; ///< System calls issued by the stage
+	std::uint64_t waits{0}; ///< Retries waited for
+	Histogram latency; ///< readBytes/writeBytes latencies
+	Histogram flushLatency; ///< drain/flush latencies
+
+	void
+	reset() noexcept;
+
+};//struct Stream::Stats
+
+
+/**
+ * Per stage recorder that is empty unless the library is built with <b>STREAM_INSTRUMENTATION</b>
+ * @class	Probe Stats.hpp "Stream/Stats.hpp"
+ */
+class Probe {
+#if defined(STREAM_INSTRUMENTATION)
+	Stats mStats;
+#endif
+
+public:
+
+	/**
+	 * Records the lifetime of itself into a histogram
+	 * @class	Timer Stats.hpp "Stream/Stats.hpp"
+	 */
+	class Timer {
+#if defined(STREAM_INSTRUMENTATION)
+		Histogram& mHistogram;
+		std::chrono::steady_clock::time_point mStart{std::chrono::steady_clock::now()};
+
+	public:
+
+		explicit
+		Timer(Histogram& histogram) noexcept
+				: mHistogram{histogram}
+		{}
+
+		~Timer()
+		{ mHistogram.record(std::chrono::steady_clock::now() - mStart); }
+#endif
+
+	};//class Stream::Probe::Timer
+
+	[[nodiscard]]
+	Timer
+	time() noexcept
+	{
+#if defined(STREAM_INSTRUMENTATION)
+		return Timer{mStats.latency};
+#else
+		return {};
+#endif
+	}
+
+	[[nodiscard]]
+	Timer
+	timeFlush() noexcept
+	{
+#if defined(STREAM_INSTRUMENTATION)
+		return Timer{mStats.flushLatency};
+#else
+		return {};
+#endif
+	}
+
+	void
+	transfer([[maybe_unused]] std::size_t bytes) noexcept
+	{
+#if defined(STREAM_INSTRUMENTATION)
+		++mStats.calls;
+		mStats.bytes += bytes;
+#endif
+	}
+
+	void
+	syscall() noexcept
+	{
+#if defined(STREAM_INSTRUMENTATION)
+		++mStats.syscalls;
+#endif
+	}
+
+	void
+	wait() noexcept
+	{
+#if defined(STREAM_INSTRUMENTATION)
+		++mStats.waits;
+#endif
+	}
+
+	/**
+	 * Call @p transfer and record its latency and the number of bytes it returns
+	 * @param[in]	transfer Callable returning std::size_t or std::expected<std::size_t, E>
+	 * @return		Result of @p transfer
+	 */
+	auto
+	measure(auto&& transfer)
+	{
+		[[maybe_unused]] auto timer{time()};
+		auto r{transfer()};
+		if constexpr (std::is_integral_v<decltype(r)>)
+			this->transfer(r);
+		else
+			this->transfer(r.value_or(0));
+		return r;
+	}
+
+	/**
+	 * Get the recorded counters, always zero unless the library is built with <b>STREAM_INSTRUMENTATION</b>
+	 */
+	[[nodiscard]]
+	Stats const&
+	getStats() const noexcept;
+
+	void
+	reset() noexcept;
+
+};//class Stream::Probe
+
+}//namespace Stream
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "InOut.hpp"
+#include <vector>
+
+
+namespace Stream {
+
+/**
+ * %Output stage that writes the same data to every linked sink
+ * @class	TeeOutput Tee.hpp "Stream/Tee.hpp"
+ * @details	Sinks are added with <b>sink < tee</b> and the data is passed to them as it is, vectored writes included,
+ *			so it is serialized once no matter how many sinks there are.
+ *			Flushing the tee flushes every sink and triggers them to do the same.
+ *			With Policy::Block the sinks that got the data of a write keep track of it when a later sink throws, so
+ *			retrying that write from the same memory with the same size only writes the rest to the sinks that did
+ *			not get it yet. Any other write starts over on every sink.
+ */
+class TeeOutput : public Output {
+
+public:
+
+	/**
+	 * What to do when a sink does not accept all of the data at once
+	 */
+	enum class Policy : unsigned char {
+		Block, ///< Wait for the sink before moving on to the next one
+		Buffer ///< Keep the rest in the backlog of the sink and wait for it only when the backlog exceeds the limit
+	};
+
+private:
+
+	struct Branch {
+		Output* mSink;
+		std::vector<std::byte> mBacklog;
+		std::size_t mBacklogPos{0}; // already written part of the backlog
+		std::size_t mDone{0}; // part of an interrupted blocking write the sink already got
+	};
+
+	std::vector<Branch> mBranches;
+	Policy mPolicy;
+	std::size_t mLimit;
+	void const* mFailedBase{nullptr}; // first area of the interrupted blocking write
+	std::size_t mFailedSize{0}; // total size of the interrupted blocking write
+
+	std::size_t
+	writeBytes(std::byte const* src, std::size_t size) final;
+
+	std::size_t
+	writeVector(std::span<::iovec const> iov) final;
+
+	void
+	flush() final;
+
+	void
+	writeBlocking(Branch& branch, std::span<::iovec const> iov);
+
+	void
+	writeBuffered(Branch& branch, std::span<::iovec const> iov);
+
+	static void
+	Settle(Branch& branch, std::size_t limit);
+
+public:
+
+	/**
+	 * Construct a tee without sinks
+	 * @param[in]	policy What to do when a sink is slow
+	 * @param[in]	limit Backlog size per sink above which Policy::Buffer waits for the sink
+	 */
+	explicit
+	TeeOutput(Policy policy = Policy::Block, std::size_t limit = 1 << 20) noexcept;
+
+	TeeOutput(TeeOutput&& other) noexcept;
+
+	friend void
+	swap(TeeOutput& a, TeeOutput& b) noexcept;
+
+	TeeOutput&
+	operator=(TeeOutput&& other) noexcept;
+
+	/**
+	 * Write the backlogs to the sinks, which must still exist
+	 */
+	~TeeOutput();
+
+	/**
+	 * Add @p sink to the sinks of @p tee
+	 */
+	template <typename S, typename T>
+	friend T&
+	operator<(S& sink, T& tee)
+	requires (std::derived_from<S, Output> &&
+		std::derived_from<T, Output> && std::derived_from<T, TeeOutput>);
+
+	/**
+	 * Remove all sinks of @p tee, the data that is not written yet is discarded
+	 */
+	template <typename T>
+	friend T&
+	operator<(std::nullptr_t, T& tee) noexcept
+	requires (std::derived_from<T, Output> && std::derived_from<T, TeeOutput>);
+
+	/**
+	 * Get the number of sinks
+	 */
+	[[nodiscard]]
+	std::size_t
+	getSinkCount() const noexcept;
+
+	/**
+	 * Get the size of the data that is waiting to be written to the sink at @p index
+	 * @pre		@p index must be less than getSinkCount()
+	 */
+	[[nodiscard]]
+	std::size_t
+	getBacklogSize(std::size_t index) const noexcept;
+
+};//class Stream::TeeOutput
+
+}//namespace Stream
+
+
+#include "../../src/Tee.tpp"
@@ -3,6 +3,7 @@
 #include "Stream/Buffer.hpp"
 #include <charconv>
 #include <limits>
+#include <span>
 
 
 namespace Stream {
@@ -12,6 +13,15 @@ class TextInput : public BufferReader {
 	TextInput&
 	checkFromChars(std::from_chars_result r);
 
+	/**
+	 * Make sure the character at @p i is in the buffer
+	 * @param[in]	i
+	 * @return		false if the source ended before @p i
+	 * @throws		Input::Exception for the errors other than the end of the source
+	 */
+	bool
+	provideAt(std::size_t i);
+
 protected:
 
 	std::size_t
@@ -41,6 +51,14 @@ protected:
 	std::size_t
 	provideDigits36(std::size_t start, std::size_t limit, unsigned base = 16);
 
+	/**
+	 * Make sure the digits of @p base from @p start are in the buffer
+	 * @return		Number of digits
+	 * @throws		Input::Exception
+	 */
+	std::size_t
+	provideDigits(std::size_t start, std::size_t limit, unsigned base);
+
 	std::pair<std::size_t, std::size_t const>
 	provideUntil(std::size_t start, std::size_t limit, char delimiter = '\n');
 
@@ -68,9 +86,35 @@ public:
 	TextInput&
 	fromChars(std::floating_point auto& f, std::chars_format fmt, std::size_t precision = 0);
 
+	/**
+	 * Read the numbers of @p values, separated by @p sep
+	 * @param[out]	values
+	 * @param[in]	sep Character between two numbers, a whitespace one stands for a run of any whitespace
+	 * @return		Self-reference
+	 * @throws		Input::Exception
+	 * @details		The numbers that end within the buffered data are converted in a loop without refills, and only
+	 *				a number that crosses the end of the data goes through operator>>().
+	 */
+	template <typename T>
+	TextInput&
+	parseArray(std::span<T> values, char sep = ',')
+	requires Integer<T> || std::floating_point<T>;
+
 	std::string_view
 	getLine(std::size_t limit = std::numeric_limits<std::size_t>::max());
 
+	/**
+	 * Get the complete lines of the buffered data, refilling only if there is none
+	 * @param[out]	lines Views of the lines, without the line endings
+	 * @param[in]	limit Maximum length of a line
+	 * @return		Number of lines, 0 at the end of the source
+	 * @throws		Input::Exception
+	 * @details		The views are valid until the next read, like the one of getLine(). The last line of the source
+	 *				does not need a line ending.
+	 */
+	std::size_t
+	getLines(std::span<std::string_view> lines, std::size_t limit = std::numeric_limits<std::size_t>::max());
+
 	std::string_view
 	getUntil(char delim = ' ', std::size_t limit = std::numeric_limits<std::size_t>::max());
 
@@ -115,6 +159,19 @@ public:
 	TextOutput&
 	toChars(std::floating_point auto f, std::chars_format fmt, std::size_t precision);
 
+	/**
+	 * Write the numbers of @p values, separated by @p sep
+	 * @param[in]	values
+	 * @param[in]	sep Character between two numbers
+	 * @return		Self-reference
+	 * @throws		Output::Exception
+	 * @details		Allocates the space of many numbers at once and converts them in a loop without allocations.
+	 */
+	template <typename T>
+	TextOutput&
+	writeArray(std::span<T const> values, char sep = ',')
+	requires Integer<T> || std::floating_point<T>;
+
 	TextOutput&
 	operator<<(Char auto const* s);
 
@@ -126,6 +183,18 @@ public:
 	TextOutput&
 	operator<<(std::basic_string_view<C> const& s);
 
+	/**
+	 * Write the sample count and the p50, p90, p99 and maximum latency bounds of @p h
+	 */
+	TextOutput&
+	operator<<(Histogram const& h);
+
+	/**
+	 * Write the counters and the latency histograms of a stage on a single line
+	 */
+	TextOutput&
+	operator<<(Stats const& s);
+
 };//class Stream::TextOutput
 
 
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "InOut.hpp"
+
+
+namespace Stream {
+
+/**
+ * Move @p size bytes from @p input to @p output
+ * @param[in]	input Source of the data
+ * @param[in]	output Sink of the data
+ * @param[in]	size Number of bytes to be moved
+ * @return		Number of bytes that are actually moved, less than @p size only if @p input ended
+ * @throws		Input::Exception
+ * @throws		Output::Exception
+ * @details		Moves the data inside the kernel when the concrete types of the endpoints allow it:
+ *				<b>copy_file_range()</b> between two File objects, <b>splice()</b> when either side is a Pipe,
+ *				<b>sendfile()</b> from a File and <b>splice()</b> through an intermediate pipe from a Socket.
+ *				Otherwise, or if the kernel refuses the shortcut, it copies through a user space buffer.
+ */
+std::size_t
+Transfer(Input& input, Output& output, std::size_t size);
+
+}//namespace Stream
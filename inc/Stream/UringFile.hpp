@@ -0,0 +1,151 @@
+#pragma once
+
+#include "File.hpp"
+#include <memory>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+
+namespace Stream {
+
+/**
+ * %File resource accessed through an io_uring submission queue
+ * @class	UringFile UringFile.hpp "Stream/UringFile.hpp"
+ * @details	Keeps up to <b>depth</b> block reads in flight ahead of the consumer and queues filled blocks as
+ *			positional writes, submitting them in batches. Like File, it has a single position shared by reading
+ *			and writing; switching direction waits for the blocks in flight.
+ *			Errors of the blocks written behind are reported by the next write or flush, and by every one after it,
+ *			since the file has a hole where the failed block was.
+ */
+class UringFile : public Input, public Output {
+	friend class StageAccess;
+
+	struct Block {
+		std::byte* mData;
+		::off_t mOffset;
+		std::size_t mSize; // read: requested/filled, write: filled
+		std::size_t mPos; // read: consumed
+		int mResult;
+		bool mPending;
+	};
+
+	enum class Direction : unsigned char {
+		None,
+		Read,
+		Write
+	};
+
+	int mDescriptor{-1};
+	int mRing{-1};
+
+	void* mRingMemory{nullptr};
+	std::size_t mRingMemorySize{0};
+	::io_uring_sqe* mEntries{nullptr};
+	std::size_t mEntriesSize{0};
+	unsigned* mSqHead{nullptr};
+	unsigned* mSqTail{nullptr};
+	unsigned* mSqArray{nullptr};
+	unsigned mSqMask{0};
+	unsigned* mCqHead{nullptr};
+	unsigned* mCqTail{nullptr};
+	::io_uring_cqe* mCqEntries{nullptr};
+	unsigned mCqMask{0};
+	unsigned mUnsubmitted{0};
+
+	std::unique_ptr<std::byte[]> mMemory;
+	std::unique_ptr<Block[]> mBlocks;
+	unsigned mDepth{0};
+	unsigned mHead{0}; // oldest block in use
+	unsigned mUsed{0}; // number of blocks in use
+	std::size_t mBlockSize{0};
+
+	Direction mDirection{Direction::None};
+	bool mAppend{false};
+	::off_t mOffset{0}; // consumed/produced position
+	::off_t mSubmitOffset{0}; // next read-ahead position
+	std::error_code mWriteError;
+
+	std::size_t
+	readBytes(std::byte* dest, std::size_t size) final;
+
+	std::size_t
+	writeBytes(std::byte const* src, std::size_t size) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) final;
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) final;
+
+	void
+	flush() final;
+
+	void
+	prepareEntry(unsigned index, unsigned char opcode) noexcept;
+
+	std::error_code
+	submit(unsigned wait) noexcept;
+
+	void
+	reap() noexcept;
+
+	std::error_code
+	waitFor(unsigned index) noexcept;
+
+	std::error_code
+	settle() noexcept;
+
+	void
+	readAhead() noexcept;
+
+	std::error_code
+	complete(Block& block) noexcept;
+
+	std::error_code
+	setDirection(Direction direction) noexcept;
+
+	void
+	release() noexcept;
+
+public:
+
+	/**
+	 * Construct an io_uring backed %File resource.
+	 * @param[in]	name Path of the file
+	 * @param[in]	mode Open mode
+	 * @param[in]	depth Number of blocks that can be in flight
+	 * @param[in]	blockSize Size of a single read/write request
+	 * @throws	File::Exception
+	 */
+	UringFile(std::string const& name, File::Mode mode, unsigned depth = 8, std::size_t blockSize = 128 * 1024);
+
+	UringFile(UringFile const&) = delete;
+
+	UringFile(UringFile&& other) noexcept;
+
+	friend void
+	swap(UringFile& a, UringFile& b) noexcept;
+
+	UringFile&
+	operator=(UringFile&& other) noexcept;
+
+	~UringFile();
+
+	/**
+	 * Get the number of blocks that can be in flight.
+	 */
+	[[nodiscard]]
+	unsigned
+	getDepth() const noexcept;
+
+	/**
+	 * Get the size of a single read/write request.
+	 */
+	[[nodiscard]]
+	std::size_t
+	getBlockSize() const noexcept;
+
+};//class Stream::UringFile
+
+}//namespace Stream
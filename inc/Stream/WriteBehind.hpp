@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Stream {
+
+/**
+ * Output stream buffer that writes behind the producer on a background thread
+ * @class	WriteBehindOutput WriteBehind.hpp "Stream/WriteBehind.hpp"
+ * @details	A full block is queued to a thread that writes it to the sink, and the producer moves on to a free
+ *			block right away. With all of the blocks queued the producer waits for the thread, so a slow sink
+ *			holds back at most the given number of blocks. An error of the sink is thrown as Output::Exception by
+ *			the next allocation or flush, and by every one after it, since the data queued behind it is lost.
+ *			The sink is written by the thread only, it must not be used by others until the buffer is destroyed.
+ *			Destroying the buffer writes the remaining data as far as the sink takes it without waiting, flush() to
+ *			wait for a slow sink first. A write that blocks in the kernel is completed, so a blocking descriptor
+ *			should have a timeout.
+ */
+class WriteBehindOutput : public BufferOutput {
+
+	struct Block {
+		std::unique_ptr<std::byte[]> mData;
+		std::size_t mCapacity;
+		std::size_t mSize{0}; // produced
+	};
+
+	std::size_t mBlockSize;
+	std::vector<Block> mBlocks;
+	std::size_t mQueued{0}; // blocks queued by the producer
+	std::size_t mWritten{0}; // blocks written by the thread
+	bool mStopped{false};
+	std::error_code mError; // of the sink, the stream is broken after it
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	Interrupt mInterrupt; // of the waits of the thread for the sink
+	std::jthread mThread;
+
+	std::expected<std::size_t, std::error_code>
+	tryAllocBytes(std::size_t size) override;
+
+	void
+	flush() override;
+
+	/**
+	 * Write the queued blocks until stopped or the sink fails
+	 */
+	void
+	run() noexcept;
+
+	/**
+	 * Queue the held block if it has data, starting the thread for the first one
+	 * @throws		std::system_error
+	 */
+	void
+	queue();
+
+	/**
+	 * Wait until at most @p count blocks are queued or the sink has failed
+	 * @return		The error of the sink
+	 */
+	std::error_code
+	wait(std::size_t count) noexcept;
+
+	/**
+	 * Present the space of the held block
+	 */
+	void
+	present() noexcept;
+
+public:
+
+	/**
+	 * Construct with the block size and the number of blocks
+	 * @param[in]	blockSize Number of bytes of a block, larger allocations get a larger block
+	 * @param[in]	depth Number of blocks, including the one held by the producer, 2 for double buffering
+	 * @pre			@p blockSize must be non-zero
+	 * @pre			@p depth must be at least 2
+	 * @throws		std::bad_alloc
+	 * @throws		std::system_error
+	 */
+	explicit
+	WriteBehindOutput(std::size_t blockSize = 64 * 1024, std::size_t depth = 2);
+
+	WriteBehindOutput(WriteBehindOutput const&) = delete;
+
+	/**
+	 * Write the remaining data that the sink takes without waiting and stop the thread
+	 */
+	~WriteBehindOutput();
+
+	/**
+	 * Get the number of blocks.
+	 */
+	[[nodiscard]]
+	std::size_t
+	getDepth() const noexcept;
+
+};//class Stream::WriteBehindOutput
+
+}//namespace Stream
@@ -1,12 +1,60 @@
 #include "Stream/Buffer.hpp"
+#include <algorithm>
 #include <cstring>
 #include <unistd.h>
 
 
 namespace Stream {
 
-BufferInput::BufferInput(std::size_t initialBufferSize)
-		: mInputBuffer{static_cast<std::byte*>(::operator new(initialBufferSize))}
+/**
+ * Allocate @p size bytes from @p resource
+ * @return		nullptr if the allocation failed
+ */
+static std::byte*
+Allocate(std::pmr::memory_resource* resource, std::size_t size, std::size_t alignment) noexcept
+{
+	try {
+		return static_cast<std::byte*>(resource->allocate(size, alignment));
+	} catch (std::bad_alloc const&) {
+		return nullptr;
+	}
+}
+
+std::size_t
+BufferPolicy::grow(std::size_t const capacity, std::size_t const size) const noexcept
+{
+	if (size > maxSize) [[unlikely]]
+		return 0;
+	if (!capacity || growthFactor <= 1)
+		return align(size);
+
+	auto newCapacity{capacity};
+	while (newCapacity < size) {
+		auto const next{static_cast<double>(newCapacity) * growthFactor};
+		if (next >= static_cast<double>(maxSize))
+			return maxSize;
+		newCapacity = std::max(newCapacity + 1, static_cast<std::size_t>(next));
+	}
+	return align(newCapacity);
+}
+
+bool
+BufferPolicy::shrinks(std::size_t const capacity, std::size_t const size) const noexcept
+{ return highWaterMark && capacity > align(highWaterMark) && size <= align(highWaterMark); }
+
+std::size_t
+BufferPolicy::align(std::size_t const size) const noexcept
+{ return alignment && size ? ::ceilz(size, alignment) * alignment : size; }
+
+/**
+ * Get the alignment that the memory of a buffer with @p policy is allocated with
+ */
+static std::size_t
+Alignment(BufferPolicy const& policy) noexcept
+{ return std::max(policy.alignment, alignof(std::max_align_t)); }
+
+BufferInput::BufferInput(std::size_t initialBufferSize, std::pmr::memory_resource* resource)
+		: mInputBuffer{static_cast<std::byte*>(resource->allocate(initialBufferSize)), {resource, initialBufferSize}}
 		, mInputBufferSize{initialBufferSize}
 		, mInputDataBeg{mInputBuffer.get()}
 		, mInputDataEnd{mInputBuffer.get()}
@@ -31,6 +79,7 @@ swap(BufferInput& a, BufferInput& b) noexcept
 	std::swap(a.mInputDataBeg, b.mInputDataBeg);
 	std::swap(a.mInputDataEnd, b.mInputDataEnd);
 	std::swap(a.mInputEnd, b.mInputEnd);
+	std::swap(a.mInputPolicy, b.mInputPolicy);
 }
 
 BufferInput&
@@ -49,35 +98,124 @@ BufferInput::readBytes(std::byte* dest, std::size_t size)
 	return size;
 }
 
+std::size_t
+BufferInput::readVector(std::span<::iovec const> iov)
+{
+	std::size_t total{0};
+	for (auto const& v : iov) {
+		auto size{total ? std::min(v.iov_len, getDataSize()) : provideSome(v.iov_len)};
+		std::memcpy(v.iov_base, mInputDataBeg, size);
+		consumed(size);
+		total += size;
+		if (size < v.iov_len)
+			break;
+	}
+	return total;
+}
+
+std::expected<std::size_t, std::error_code>
+BufferInput::tryReadBytes(std::byte* dest, std::size_t size)
+{
+	auto r{tryProvideSome(size)};
+	if (r) {
+		std::memcpy(dest, mInputDataBeg, *r);
+		consumed(*r);
+	}
+	return r;
+}
+
 std::size_t
 BufferInput::provideBytes(std::size_t const size)
 {
-	if (size > mInputBufferSize) { // buffer is not large enough to fill with requested size of data
-		auto newInputBufferSize{
-			mInputBufferSize
-				? ::ceilz(size, mInputBufferSize) * mInputBufferSize
-				: size
-		};
-		auto* ptr{static_cast<std::byte*>(::operator new(newInputBufferSize, std::nothrow_t{}))};
-		if (!ptr) [[unlikely]]
-			throw Exception{Buffer::Exception::Code::BadAllocation};
-
-		std::memcpy(ptr, mInputDataBeg, mInputDataEnd - mInputDataBeg);
-		mInputBuffer.reset(ptr);
-		mInputBufferSize = newInputBufferSize;
-		mInputDataEnd += ptr - mInputDataBeg;
-		mInputDataBeg = ptr;
-		mInputEnd = ptr + newInputBufferSize;
-	} else if (mInputDataBeg + size > mInputEnd || // shift the existing data if the remaining space is not enough
+	auto r{tryProvideBytes(size)};
+	if (!r) [[unlikely]]
+		throw Exception{r.error()};
+	return *r;
+}
+
+std::expected<std::size_t, std::error_code>
+BufferInput::tryProvideBytes(std::size_t const size)
+{
+	if (mInputDataBeg == mInputDataEnd && mInputPolicy.releaseEmpty) [[unlikely]]
+		return tryProvideReleased(size);
+	if (!prepareInput(size)) [[unlikely]]
+		return std::unexpected{make_error_code(Buffer::Exception::Code::BadAllocation)};
+
+	auto r{getSource().tryReadSome(mInputDataEnd, mInputEnd - mInputDataEnd)};
+	if (!r)
+		return r;
+	mInputDataEnd += *r;
+	return std::min(size, static_cast<std::size_t>(mInputDataEnd - mInputDataBeg));
+}
+
+/**
+ * @details	The memory of a drained buffer is given back here rather than by consumed(), the views into it are over
+ *			by now. It is borrowed for a single read attempt at a time, so a source that signals for retry is waited
+ *			for without holding it. A blocking descriptor is waited for inside the read, with the memory held.
+ */
+std::expected<std::size_t, std::error_code>
+BufferInput::tryProvideReleased(std::size_t const size)
+{
+	auto& source{getSource()};
+	for (unsigned attempt{0};; ++attempt) {
+		if (!prepareInput(size)) [[unlikely]]
+			return std::unexpected{make_error_code(Buffer::Exception::Code::BadAllocation)};
+		auto r{TryReadBytes(source, mInputDataEnd, mInputEnd - mInputDataEnd)};
+		if (r && *r) {
+			mInputDataEnd += *r;
+			return std::min(size, static_cast<std::size_t>(mInputDataEnd - mInputDataBeg));
+		}
+		releaseInput(); // idle until data arrives
+		if (!r)
+			return r;
+		if (auto ec{WaitReadable(source, attempt)})
+			return std::unexpected{ec};
+	}
+}
+
+bool
+BufferInput::prepareInput(std::size_t const size) noexcept
+{
+	auto const dataSize{static_cast<std::size_t>(mInputDataEnd - mInputDataBeg)};
+	// with an alignment the data is shifted by whole blocks only, so that the reads stay aligned
+	auto const skew{mInputPolicy.alignment && mInputBuffer ? static_cast<std::size_t>(mInputDataBeg - mInputBuffer.get()) % mInputPolicy.alignment : 0};
+	auto newInputBufferSize{mInputBufferSize};
+	if (size + skew > mInputBufferSize) // buffer is not large enough to fill with requested size of data
+		newInputBufferSize = mInputPolicy.grow(mInputBufferSize, size + skew);
+	else if (mInputBuffer && mInputPolicy.shrinks(mInputBufferSize, std::max(size, dataSize) + skew)) // release the memory of a large message that has passed
+		newInputBufferSize = mInputPolicy.align(mInputPolicy.highWaterMark);
+
+	if (newInputBufferSize != mInputBufferSize || (!mInputBuffer && mInputBufferSize)) // grow, shrink or borrow the memory back
+		return reallocInput(newInputBufferSize, skew);
+
+	if (mInputDataBeg + size > mInputEnd || // shift the existing data if the remaining space is not enough
 		mInputEnd - mInputDataEnd <= mInputDataBeg - mInputBuffer.get() // shift the existing data if the remaining space will at least double
 	) {
-		std::memcpy(mInputBuffer.get(), mInputDataBeg, mInputDataEnd - mInputDataBeg);
-		mInputDataEnd += mInputBuffer.get() - mInputDataBeg;
-		mInputDataBeg = mInputBuffer.get();
+		auto* const dest{mInputBuffer.get() + skew};
+		std::memmove(dest, mInputDataBeg, dataSize);
+		mInputDataEnd = dest + dataSize;
+		mInputDataBeg = dest;
 	}
+	return true;
+}
 
-	mInputDataEnd += getSource().readSome(mInputDataEnd, mInputEnd - mInputDataEnd);
-	return std::min(size, static_cast<std::size_t>(mInputDataEnd - mInputDataBeg));
+bool
+BufferInput::reallocInput(std::size_t const size, std::size_t const skew) noexcept
+{
+	auto const dataSize{static_cast<std::size_t>(mInputDataEnd - mInputDataBeg)};
+	auto const alignment{Alignment(mInputPolicy)};
+	auto* ptr{size ? Allocate(getInputResource(), size, alignment) : nullptr};
+	if (!ptr) [[unlikely]]
+		return false;
+
+	if (dataSize)
+		std::memcpy(ptr + skew, mInputDataBeg, dataSize);
+	mInputBuffer = {ptr, {getInputResource(), size, alignment}};
+	mInputBufferSize = size;
+	mInputDataBeg = ptr + skew;
+	mInputDataEnd = ptr + skew + dataSize;
+	mInputEnd = ptr + size;
+	return true;
 }
 
 std::size_t
@@ -110,9 +248,42 @@ BufferInput::provide(std::size_t const size)
 	return size;
 }
 
+std::expected<std::size_t, std::error_code>
+BufferInput::tryProvideSomeMore(std::size_t const size)
+{
+	if (size)
+		return tryProvideBytes((mInputDataEnd - mInputDataBeg) + size);
+
+	return mInputDataEnd - mInputDataBeg;
+}
+
+std::expected<std::size_t, std::error_code>
+BufferInput::tryProvideSome(std::size_t const size)
+{
+	if (size <= mInputDataEnd - mInputDataBeg) // there is enough data
+		return size;
+
+	if (mInputDataEnd != mInputDataBeg) // there is some data
+		return mInputDataEnd - mInputDataBeg;
+
+	return tryProvideBytes(size);
+}
+
+std::expected<std::size_t, std::error_code>
+BufferInput::tryProvide(std::size_t const size)
+{
+	while (size > mInputDataEnd - mInputDataBeg) // there is not enough data
+		if (auto r{tryProvideBytes(size)}; !r)
+			return r;
+
+	return size;
+}
+
 void
 BufferInput::consumed(std::size_t const size) noexcept
-{ mInputDataBeg += size; }
+{
+	mInputDataBeg += size;
+}
 
 std::size_t
 BufferInput::getDataSize() const noexcept
@@ -130,9 +301,42 @@ std::byte const*
 BufferInput::end() const noexcept
 { return mInputDataEnd; }
 
+std::pmr::memory_resource*
+BufferInput::getInputResource() const noexcept
+{ return mInputBuffer.get_deleter().resource; }
+
+void
+BufferInput::setInputPolicy(BufferPolicy const& policy) noexcept
+{
+	mInputPolicy = policy;
+	if (mInputDataBeg == mInputDataEnd && mInputPolicy.releaseEmpty && mInputBuffer)
+		releaseInput();
+	else if (mInputBuffer && (
+		mInputBuffer.get_deleter().alignment < Alignment(mInputPolicy) ||
+		mInputPolicy.align(mInputBufferSize) != mInputBufferSize)
+	)
+		reallocInput(mInputPolicy.align(mInputBufferSize), 0);
+}
+
+BufferPolicy const&
+BufferInput::getInputPolicy() const noexcept
+{ return mInputPolicy; }
+
+void
+BufferInput::releaseInput() noexcept
+{
+	mInputBuffer.reset();
+	mInputDataBeg = mInputDataEnd = nullptr;
+	mInputEnd = nullptr;
+}
+
+std::size_t
+BufferInput::getInputCapacity() const noexcept
+{ return mInputBufferSize; }
+
 
-BufferOutput::BufferOutput(std::size_t initialBufferSize)
-		: mOutputBuffer{static_cast<std::byte*>(::operator new(initialBufferSize))}
+BufferOutput::BufferOutput(std::size_t initialBufferSize, std::pmr::memory_resource* resource)
+		: mOutputBuffer{static_cast<std::byte*>(resource->allocate(initialBufferSize)), {resource, initialBufferSize}}
 		, mOutputBufferSize{initialBufferSize}
 		, mOutputDataBeg{mOutputBuffer.get()}
 		, mOutputDataEnd{mOutputBuffer.get()}
@@ -157,6 +361,7 @@ swap(BufferOutput& a, BufferOutput& b) noexcept
 	std::swap(a.mOutputDataBeg, b.mOutputDataBeg);
 	std::swap(a.mOutputDataEnd, b.mOutputDataEnd);
 	std::swap(a.mOutputEnd, b.mOutputEnd);
+	std::swap(a.mOutputPolicy, b.mOutputPolicy);
 }
 
 BufferOutput&
@@ -185,6 +390,32 @@ BufferOutput::writeBytes(std::byte const* src, std::size_t size)
 	return size;
 }
 
+std::size_t
+BufferOutput::writeVector(std::span<::iovec const> iov)
+{
+	std::size_t total{0};
+	for (auto const& v : iov) {
+		auto size{total ? std::min(v.iov_len, getSpaceSize()) : allocSome(v.iov_len)};
+		std::memcpy(mOutputDataEnd, v.iov_base, size);
+		produced(size);
+		total += size;
+		if (size < v.iov_len)
+			break;
+	}
+	return total;
+}
+
+std::expected<std::size_t, std::error_code>
+BufferOutput::tryWriteBytes(std::byte const* src, std::size_t size)
+{
+	auto r{tryAllocSome(size)};
+	if (r) {
+		std::memcpy(mOutputDataEnd, src, *r);
+		produced(*r);
+	}
+	return r;
+}
+
 void
 BufferOutput::flush()
 {
@@ -194,39 +425,78 @@ BufferOutput::flush()
 		mOutputDataBeg = static_cast<std::byte const*>(exc.getUnwrittenBuffer());
 		throw;
 	}
+	if (!mOutputEnd) // the memory is given back
+		return;
 	mOutputDataBeg = const_cast<std::byte const*&>(mOutputDataEnd) = mOutputEnd - mOutputBufferSize;
+	if (mOutputPolicy.releaseEmpty && mOutputBuffer)
+		releaseOutput();
+	else if (mOutputPolicy.shrinks(mOutputBufferSize, 0)) // nothing is left to copy, a failure keeps the large buffer
+		prepareOutput(0);
 }
 
 std::size_t
 BufferOutput::allocBytes(std::size_t const size)
 {
-	mOutputDataBeg += getSink().writeSome(mOutputDataBeg, mOutputDataEnd - mOutputDataBeg);
-
-	if ((mOutputDataEnd - mOutputDataBeg) + size > mOutputBufferSize) {
-		auto newOutputBufferSize{
-			mOutputBufferSize
-				? ::ceilz((mOutputDataEnd - mOutputDataBeg) + size, mOutputBufferSize) * mOutputBufferSize
-				: (mOutputDataEnd - mOutputDataBeg) + size
-		};
-		auto* ptr{static_cast<std::byte*>(::operator new(newOutputBufferSize, std::nothrow_t{}))};
-		if (!ptr) [[unlikely]]
-			throw Exception{Buffer::Exception::Code::BadAllocation};
-
-		std::memcpy(ptr, mOutputDataBeg, mOutputDataEnd - mOutputDataBeg);
-		mOutputBuffer.reset(ptr);
-		mOutputBufferSize = newOutputBufferSize;
-		mOutputDataEnd += ptr - mOutputDataBeg;
-		mOutputDataBeg = ptr;
-		mOutputEnd = ptr + newOutputBufferSize;
-	} else {
-		std::memcpy(mOutputBuffer.get(), mOutputDataBeg, mOutputDataEnd - mOutputDataBeg);
-		mOutputDataEnd += mOutputBuffer.get() - mOutputDataBeg;
-		mOutputDataBeg = mOutputBuffer.get();
-	}
+	auto r{tryAllocBytes(size)};
+	if (!r) [[unlikely]]
+		throw Exception{r.error()};
+	return *r;
+}
 
+std::expected<std::size_t, std::error_code>
+BufferOutput::tryAllocBytes(std::size_t const size)
+{
+	auto pending{static_cast<std::size_t>(mOutputDataEnd - mOutputDataBeg)};
+	if (mOutputPolicy.alignment) // write whole blocks only, the rest goes with the following data or by flush()
+		pending -= pending % mOutputPolicy.alignment;
+	auto r{getSink().tryWriteSome(mOutputDataBeg, pending)};
+	if (!r)
+		return r;
+	mOutputDataBeg += *r;
+
+	if (!prepareOutput(size)) [[unlikely]]
+		return std::unexpected{make_error_code(Buffer::Exception::Code::BadAllocation)};
 	return std::min(size, static_cast<std::size_t>(mOutputEnd - mOutputDataEnd));
 }
 
+bool
+BufferOutput::prepareOutput(std::size_t const size) noexcept
+{
+	auto const dataSize{static_cast<std::size_t>(mOutputDataEnd - mOutputDataBeg)};
+	auto newOutputBufferSize{mOutputBufferSize};
+	if (dataSize + size > mOutputBufferSize)
+		newOutputBufferSize = mOutputPolicy.grow(mOutputBufferSize, dataSize + size);
+	else if (mOutputBuffer && mOutputPolicy.shrinks(mOutputBufferSize, dataSize + size)) // release the memory of a large message that has passed
+		newOutputBufferSize = mOutputPolicy.align(mOutputPolicy.highWaterMark);
+
+	if (newOutputBufferSize != mOutputBufferSize || (!mOutputBuffer && mOutputBufferSize)) // grow, shrink or borrow the memory back
+		return reallocOutput(newOutputBufferSize);
+
+	std::memmove(mOutputBuffer.get(), mOutputDataBeg, dataSize);
+	mOutputDataEnd += mOutputBuffer.get() - mOutputDataBeg;
+	mOutputDataBeg = mOutputBuffer.get();
+	return true;
+}
+
+bool
+BufferOutput::reallocOutput(std::size_t const size) noexcept
+{
+	auto const dataSize{static_cast<std::size_t>(mOutputDataEnd - mOutputDataBeg)};
+	auto const alignment{Alignment(mOutputPolicy)};
+	auto* ptr{size ? Allocate(getOutputResource(), size, alignment) : nullptr};
+	if (!ptr) [[unlikely]]
+		return false;
+
+	if (dataSize)
+		std::memcpy(ptr, mOutputDataBeg, dataSize);
+	mOutputBuffer = {ptr, {getOutputResource(), size, alignment}};
+	mOutputBufferSize = size;
+	mOutputDataBeg = ptr;
+	mOutputDataEnd = ptr + dataSize;
+	mOutputEnd = ptr + size;
+	return true;
+}
+
 std::size_t
 BufferOutput::allocSomeMore(std::size_t const size)
 {
@@ -257,6 +527,37 @@ BufferOutput::alloc(std::size_t const size)
 	return size;
 }
 
+std::expected<std::size_t, std::error_code>
+BufferOutput::tryAllocSomeMore(std::size_t const size)
+{
+	if (size)
+		return tryAllocBytes((mOutputEnd - mOutputDataEnd) + size);
+
+	return mOutputEnd - mOutputDataEnd;
+}
+
+std::expected<std::size_t, std::error_code>
+BufferOutput::tryAllocSome(std::size_t const size)
+{
+	if (size <= mOutputEnd - mOutputDataEnd) // there is enough space
+		return size;
+
+	if (mOutputEnd != mOutputDataEnd) // there is some space
+		return mOutputEnd - mOutputDataEnd;
+
+	return tryAllocBytes(size);
+}
+
+std::expected<std::size_t, std::error_code>
+BufferOutput::tryAlloc(std::size_t const size)
+{
+	while (size > mOutputEnd - mOutputDataEnd) // there is not enough space
+		if (auto r{tryAllocBytes(size)}; !r)
+			return r;
+
+	return size;
+}
+
 void
 BufferOutput::produced(std::size_t size) noexcept
 { mOutputDataEnd += size; }
@@ -273,26 +574,59 @@ std::byte const*
 BufferOutput::end() const noexcept
 { return mOutputEnd; }
 
+std::pmr::memory_resource*
+BufferOutput::getOutputResource() const noexcept
+{ return mOutputBuffer.get_deleter().resource; }
+
+void
+BufferOutput::setOutputPolicy(BufferPolicy const& policy) noexcept
+{
+	mOutputPolicy = policy;
+	if (mOutputDataBeg == mOutputDataEnd && mOutputPolicy.releaseEmpty && mOutputBuffer)
+		releaseOutput();
+	else if (mOutputBuffer && (
+		mOutputBuffer.get_deleter().alignment < Alignment(mOutputPolicy) ||
+		mOutputPolicy.align(mOutputBufferSize) != mOutputBufferSize)
+	)
+		reallocOutput(mOutputPolicy.align(mOutputBufferSize));
+}
+
+BufferPolicy const&
+BufferOutput::getOutputPolicy() const noexcept
+{ return mOutputPolicy; }
+
+void
+BufferOutput::releaseOutput() noexcept
+{
+	mOutputBuffer.reset();
+	mOutputDataBeg = mOutputDataEnd = nullptr;
+	mOutputEnd = nullptr;
+}
+
+std::size_t
+BufferOutput::getOutputCapacity() const noexcept
+{ return mOutputBufferSize; }
+
 
-Buffer::Buffer(std::size_t buffInitialSize)
-		: BufferInput{buffInitialSize}
-		, BufferOutput{buffInitialSize}
+Buffer::Buffer(std::size_t buffInitialSize, std::pmr::memory_resource* resource)
+		: BufferInput{buffInitialSize, resource}
+		, BufferOutput{buffInitialSize, resource}
 {}
 
-Buffer::Buffer(std::size_t inBuffInitialSize, std::size_t outBuffInitialSize)
-		: BufferInput{inBuffInitialSize}
-		, BufferOutput{outBuffInitialSize}
+Buffer::Buffer(std::size_t inBuffInitialSize, std::size_t outBuffInitialSize, std::pmr::memory_resource* resource)
+		: BufferInput{inBuffInitialSize, resource}
+		, BufferOutput{outBuffInitialSize, resource}
 {}
 
-Buffer::Buffer(std::size_t inBuffInitialSize, void* sinkBuff, std::size_t sinkSize)
-		: BufferInput{inBuffInitialSize}
+Buffer::Buffer(std::size_t inBuffInitialSize, void* sinkBuff, std::size_t sinkSize, std::pmr::memory_resource* resource)
+		: BufferInput{inBuffInitialSize, resource}
 		, BufferOutput{sinkBuff, sinkSize}
-{}
+{ mOutputBuffer.get_deleter().resource = resource; }
 
-Buffer::Buffer(void const* sourceBuff, std::size_t sourceSize, std::size_t outBuffInitialSize)
+Buffer::Buffer(void const* sourceBuff, std::size_t sourceSize, std::size_t outBuffInitialSize, std::pmr::memory_resource* resource)
 		: BufferInput{sourceBuff, sourceSize}
-		, BufferOutput{outBuffInitialSize}
-{}
+		, BufferOutput{outBuffInitialSize, resource}
+{ mInputBuffer.get_deleter().resource = resource; }
 
 Buffer::Buffer(void const* sourceBuff, std::size_t sourceSize, void* sinkBuff, std::size_t sinkSize) noexcept
 		: BufferInput{sourceBuff, sourceSize}
@@ -313,9 +647,13 @@ static class : public BufferInput {
 	readBytes(std::byte*, std::size_t) override
 	{ throw Exception{std::make_error_code(std::errc::no_message_available)}; }
 
-	std::size_t
-	provideBytes(std::size_t) override
-	{ throw Exception{std::make_error_code(std::errc::no_message_available)}; }
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte*, std::size_t) override
+	{ return std::unexpected{std::make_error_code(std::errc::no_message_available)}; }
+
+	std::expected<std::size_t, std::error_code>
+	tryProvideBytes(std::size_t) override
+	{ return std::unexpected{std::make_error_code(std::errc::no_message_available)}; }
 
 } unreadable;
 BufferInput* BufferReader::Unreadable = &unreadable;
@@ -327,9 +665,17 @@ size_t
 BufferReader::readBytes(std::byte* dest, std::size_t size)
 { return getSource().readSome(dest, size); }
 
+std::size_t
+BufferReader::readVector(std::span<::iovec const> iov)
+{ return getSource().readSome(iov); }
+
+std::expected<std::size_t, std::error_code>
+BufferReader::tryReadBytes(std::byte* dest, std::size_t size)
+{ return getSource().tryReadSome(dest, size); }
+
 BufferInput&
 BufferReader::getSource() noexcept
-{ return reinterpret_cast<BufferInput&>(Input::getSource()); }
+{ return static_cast<BufferInput&>(Input::getSource()); }
 
 
 static class : public BufferOutput {
@@ -338,9 +684,13 @@ static class : public BufferOutput {
 	writeBytes(std::byte const*, std::size_t) override
 	{ throw Exception{std::make_error_code(std::errc::no_space_on_device)}; }
 
-	std::size_t
-	allocBytes(std::size_t) override
-	{ throw Exception{std::make_error_code(std::errc::no_space_on_device)}; }
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const*, std::size_t) override
+	{ return std::unexpected{std::make_error_code(std::errc::no_space_on_device)}; }
+
+	std::expected<std::size_t, std::error_code>
+	tryAllocBytes(std::size_t) override
+	{ return std::unexpected{std::make_error_code(std::errc::no_space_on_device)}; }
 
 } unwritable;
 BufferOutput* BufferWriter::Unwritable = &unwritable;
@@ -353,9 +703,17 @@ std::size_t
 BufferWriter::writeBytes(std::byte const* src, std::size_t size)
 { return getSink().writeSome(src, size); }
 
+std::size_t
+BufferWriter::writeVector(std::span<::iovec const> iov)
+{ return getSink().writeSome(iov); }
+
+std::expected<std::size_t, std::error_code>
+BufferWriter::tryWriteBytes(std::byte const* src, std::size_t size)
+{ return getSink().tryWriteSome(src, size); }
+
 BufferOutput&
 BufferWriter::getSink() noexcept
-{ return reinterpret_cast<BufferOutput&>(Output::getSink()); }
+{ return static_cast<BufferOutput&>(Output::getSink()); }
 
 
 std::error_code
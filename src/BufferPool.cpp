@@ -0,0 +1,150 @@
+#include "Stream/BufferPool.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+
+namespace Stream {
+
+static constexpr std::size_t ClassCount{std::countr_zero(BufferPool::MaxClassSize) - std::countr_zero(BufferPool::MinClassSize) + 1};
+
+/**
+ * Free blocks of a thread, given back to the upstream resources when the thread exits
+ */
+class ThreadCache {
+
+	struct Entry {
+		std::uint64_t mPool; // id, unlike the address it is not reused by a later pool
+		std::pmr::memory_resource* mUpstream;
+		std::array<std::vector<void*>, ClassCount> mFree;
+	};
+
+	std::vector<Entry> mEntries;
+
+public:
+
+	std::array<std::vector<void*>, ClassCount>*
+	find(std::uint64_t pool) noexcept
+	{
+		auto const entry{std::ranges::find(mEntries, pool, &Entry::mPool)};
+		return entry == mEntries.end() ? nullptr : &entry->mFree;
+	}
+
+	std::array<std::vector<void*>, ClassCount>&
+	get(std::uint64_t pool, std::pmr::memory_resource* upstream, std::size_t cacheSize)
+	{
+		if (auto* free{find(pool)})
+			return *free;
+		auto& entry{mEntries.emplace_back(pool, upstream)};
+		for (auto& free : entry.mFree)
+			free.reserve(cacheSize);
+		return entry.mFree;
+	}
+
+	void
+	trim(std::uint64_t pool) noexcept
+	{
+		auto const entry{std::ranges::find(mEntries, pool, &Entry::mPool)};
+		if (entry == mEntries.end())
+			return;
+		Trim(*entry);
+		mEntries.erase(entry);
+	}
+
+	~ThreadCache()
+	{
+		for (auto& entry : mEntries)
+			Trim(entry);
+	}
+
+private:
+
+	static void
+	Trim(Entry& entry) noexcept
+	{
+		for (std::size_t i{0}; i < ClassCount; ++i)
+			for (auto* p : entry.mFree[i])
+				entry.mUpstream->deallocate(p, BufferPool::MinClassSize << i);
+	}
+
+};//class Stream::ThreadCache
+
+static thread_local ThreadCache Cache;
+
+static std::atomic<std::uint64_t> NextId{0};
+
+/**
+ * Get the index of the size class of @p size
+ * @pre		@p size must be pooled
+ */
+static std::size_t
+ClassIndex(std::size_t size) noexcept
+{ return std::bit_width(size - 1) - std::countr_zero(BufferPool::MinClassSize); }
+
+BufferPool::BufferPool(std::size_t cacheSize, std::pmr::memory_resource* upstream) noexcept
+		: mUpstream{upstream}
+		, mCacheSize{cacheSize}
+		, mId{NextId.fetch_add(1, std::memory_order_relaxed)}
+{}
+
+BufferPool::~BufferPool()
+{ trim(); }
+
+void*
+BufferPool::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+	auto const classSize{GetClassSize(bytes)};
+	if (!classSize || alignment > alignof(std::max_align_t))
+		return mUpstream->allocate(bytes, alignment);
+
+	auto& free{Cache.get(mId, mUpstream, mCacheSize)[ClassIndex(bytes)]};
+	if (free.empty())
+		return mUpstream->allocate(classSize);
+	auto* p{free.back()};
+	free.pop_back();
+	return p;
+}
+
+void
+BufferPool::do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+{
+	auto const classSize{GetClassSize(bytes)};
+	if (!classSize || alignment > alignof(std::max_align_t))
+		return mUpstream->deallocate(p, bytes, alignment);
+
+	try { // a thread that never allocated from the pool needs a cache first
+		auto& free{Cache.get(mId, mUpstream, mCacheSize)[ClassIndex(bytes)]};
+		if (free.size() < mCacheSize) {
+			free.push_back(p);
+			return;
+		}
+	} catch (std::bad_alloc const&) {}
+	mUpstream->deallocate(p, classSize);
+}
+
+bool
+BufferPool::do_is_equal(std::pmr::memory_resource const& other) const noexcept
+{ return this == &other; }
+
+std::size_t
+BufferPool::GetClassSize(std::size_t size) noexcept
+{ return size >= MinClassSize && size <= MaxClassSize ? std::bit_ceil(size) : 0; }
+
+std::size_t
+BufferPool::getCachedSize() const noexcept
+{
+	std::size_t total{0};
+	if (auto const* free{Cache.find(mId)})
+		for (std::size_t i{0}; i < ClassCount; ++i)
+			total += (*free)[i].size() * (MinClassSize << i);
+	return total;
+}
+
+void
+BufferPool::trim() noexcept
+{ Cache.trim(mId); }
+
+}//namespace Stream
@@ -0,0 +1,361 @@
+#pragma once
+
+#include "Stream/Chain.hpp"
+
+
+namespace Stream {
+
+template <typename ... Stages>
+template <typename T, typename S>
+class Chain<Stages ...>::BufferInputLink : public T {
+	friend class Chain;
+	S* mStaticSource{nullptr};
+
+protected:
+
+	std::expected<std::size_t, std::error_code>
+	tryProvideBytes(std::size_t size) final
+	{
+		if (&this->Input::getSource() != mStaticSource) [[unlikely]] // relinked at runtime
+			return T::tryProvideBytes(size);
+		if (!this->prepareInput(size)) [[unlikely]]
+			return std::unexpected{make_error_code(Buffer::Exception::Code::BadAllocation)};
+
+		auto r{TryReadSome(*mStaticSource, this->mInputDataEnd, this->mInputEnd - this->mInputDataEnd)};
+		if (!r)
+			return r;
+		this->mInputDataEnd += *r;
+		return std::min(size, static_cast<std::size_t>(this->mInputDataEnd - this->mInputDataBeg));
+	}
+
+public:
+
+	using T::T;
+
+};//class Stream::Chain::BufferInputLink
+
+
+template <typename ... Stages>
+template <typename T, typename S>
+class Chain<Stages ...>::BufferReaderLink : public T {
+	friend class Chain;
+	S* mStaticSource{nullptr};
+
+protected:
+
+	std::size_t
+	readBytes(std::byte* dest, std::size_t size) final
+	{
+		if (&this->Input::getSource() != mStaticSource) [[unlikely]] // relinked at runtime
+			return T::readBytes(dest, size);
+		return ReadSome(*mStaticSource, dest, size);
+	}
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) final
+	{
+		if (&this->Input::getSource() != mStaticSource) [[unlikely]] // relinked at runtime
+			return T::tryReadBytes(dest, size);
+		return TryReadSome(*mStaticSource, dest, size);
+	}
+
+public:
+
+	using T::T;
+
+};//class Stream::Chain::BufferReaderLink
+
+
+template <typename ... Stages>
+template <typename T, typename S>
+class Chain<Stages ...>::BufferOutputLink : public T {
+	friend class Chain;
+	S* mStaticSink{nullptr};
+
+protected:
+
+	std::expected<std::size_t, std::error_code>
+	tryAllocBytes(std::size_t size) final
+	{
+		if (&this->Output::getSink() != mStaticSink) [[unlikely]] // relinked at runtime
+			return T::tryAllocBytes(size);
+
+		auto r{TryWriteSome(*mStaticSink, this->mOutputDataBeg, this->mOutputDataEnd - this->mOutputDataBeg)};
+		if (!r)
+			return r;
+		this->mOutputDataBeg += *r;
+
+		if (!this->prepareOutput(size)) [[unlikely]]
+			return std::unexpected{make_error_code(Buffer::Exception::Code::BadAllocation)};
+		return std::min(size, static_cast<std::size_t>(this->mOutputEnd - this->mOutputDataEnd));
+	}
+
+public:
+
+	using T::T;
+
+};//class Stream::Chain::BufferOutputLink
+
+
+template <typename ... Stages>
+template <typename T, typename S>
+class Chain<Stages ...>::BufferWriterLink : public T {
+	friend class Chain;
+	S* mStaticSink{nullptr};
+
+protected:
+
+	std::size_t
+	writeBytes(std::byte const* src, std::size_t size) final
+	{
+		if (&this->Output::getSink() != mStaticSink) [[unlikely]] // relinked at runtime
+			return T::writeBytes(src, size);
+		return WriteSome(*mStaticSink, src, size);
+	}
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) final
+	{
+		if (&this->Output::getSink() != mStaticSink) [[unlikely]] // relinked at runtime
+			return T::tryWriteBytes(src, size);
+		return TryWriteSome(*mStaticSink, src, size);
+	}
+
+public:
+
+	using T::T;
+
+};//class Stream::Chain::BufferWriterLink
+
+
+template <typename ... Stages>
+template <typename ... Done>
+struct Chain<Stages ...>::Build<std::tuple<Done ...>>
+{ using type = std::tuple<Done ...>; };
+
+template <typename ... Stages>
+template <typename T, typename ... Rest>
+struct Chain<Stages ...>::Build<std::tuple<>, T, Rest ...>
+{ using type = typename Build<std::tuple<T>, Rest ...>::type; };
+
+template <typename ... Stages>
+template <typename ... Done, typename T, typename ... Rest>
+struct Chain<Stages ...>::Build<std::tuple<Done ...>, T, Rest ...>
+{ using type = typename Build<std::tuple<Done ..., Stage<T, std::tuple_element_t<sizeof...(Done) - 1, std::tuple<Done ...>>>>, Rest ...>::type; };
+
+
+template <typename ... Stages>
+template <std::size_t I, typename T>
+struct Chain<Stages ...>::Node {
+	T mStage;
+
+	template <typename Args>
+	explicit
+	Node(Args&& args)
+			: mStage(std::make_from_tuple<T>(std::forward<Args>(args)))
+	{}
+
+};//struct Stream::Chain::Node
+
+template <typename ... Stages>
+template <std::size_t ... I>
+struct Chain<Stages ...>::Storage<std::index_sequence<I ...>> : Node<I, std::tuple_element_t<I, Types>> ... {
+
+	template <typename ... Args>
+	explicit
+	Storage(Args&& ... args)
+			: Node<I, std::tuple_element_t<I, Types>>{std::forward<Args>(args)} ...
+	{}
+
+};//struct Stream::Chain::Storage
+
+
+template <typename ... Stages>
+template <typename S, typename T>
+void
+Chain<Stages ...>::Connect(S& s, T& t) noexcept
+{
+	if constexpr (Source<S> && Source<T>) {
+		s > t;
+		if constexpr (requires { t.mStaticSource = &s; })
+			t.mStaticSource = &s;
+	}
+	if constexpr (Sink<S> && Sink<T>) {
+		s < t;
+		if constexpr (requires { t.mStaticSink = &s; })
+			t.mStaticSink = &s;
+	}
+}
+
+template <typename ... Stages>
+template <std::size_t ... I>
+void
+Chain<Stages ...>::connect(std::index_sequence<I ...>) noexcept
+{ (Connect(get<I>(), get<I + 1>()), ...); }
+
+template <typename ... Stages>
+template <typename S>
+std::size_t
+Chain<Stages ...>::ReadSome(S& source, std::byte* dest, std::size_t size)
+{
+	auto& probe{source.getInputProbe()};
+	std::size_t outl;
+	for (unsigned attempt{0}; !(outl = probe.measure([&] { return StageAccess::ReadBytes(source, dest, size); })); ++attempt) {
+		probe.wait();
+		if (auto ec{StageAccess::WaitReadable(source, attempt)})
+			throw Input::Exception{ec};
+	}
+	return outl;
+}
+
+template <typename ... Stages>
+template <typename S>
+std::expected<std::size_t, std::error_code>
+Chain<Stages ...>::TryReadSome(S& source, std::byte* dest, std::size_t size)
+{
+	auto& probe{source.getInputProbe()};
+	if (size)
+		for (unsigned attempt{0};; ++attempt) {
+			if (auto r{probe.measure([&] { return StageAccess::TryReadBytes(source, dest, size); })}; !r || *r)
+				return r;
+			probe.wait();
+			if (auto ec{StageAccess::WaitReadable(source, attempt)})
+				return std::unexpected{ec};
+		}
+	return 0;
+}
+
+template <typename ... Stages>
+template <typename S>
+std::size_t
+Chain<Stages ...>::WriteSome(S& sink, std::byte const* src, std::size_t size)
+{
+	auto& probe{sink.getOutputProbe()};
+	std::size_t inl;
+	for (unsigned attempt{0}; !(inl = probe.measure([&] { return StageAccess::WriteBytes(sink, src, size); })); ++attempt) {
+		probe.wait();
+		if (auto ec{StageAccess::WaitWritable(sink, attempt)})
+			throw Output::Exception{ec};
+	}
+	return inl;
+}
+
+template <typename ... Stages>
+template <typename S>
+std::expected<std::size_t, std::error_code>
+Chain<Stages ...>::TryWriteSome(S& sink, std::byte const* src, std::size_t size)
+{
+	auto& probe{sink.getOutputProbe()};
+	if (size)
+		for (unsigned attempt{0};; ++attempt) {
+			if (auto r{probe.measure([&] { return StageAccess::TryWriteBytes(sink, src, size); })}; !r || *r)
+				return r;
+			probe.wait();
+			if (auto ec{StageAccess::WaitWritable(sink, attempt)})
+				return std::unexpected{ec};
+		}
+	return 0;
+}
+
+template <typename ... Stages>
+template <typename ... Args>
+Chain<Stages ...>::Chain(Args&& ... args)
+requires (sizeof...(Args) == sizeof...(Stages))
+		: mStages{std::forward<Args>(args) ...}
+{ connect(std::make_index_sequence<sizeof...(Stages) - 1>{}); }
+
+template <typename ... Stages>
+template <std::size_t I>
+Chain<Stages ...>::StageType<I>&
+Chain<Stages ...>::get() noexcept
+{ return static_cast<Node<I, StageType<I>>&>(mStages).mStage; }
+
+template <typename ... Stages>
+Chain<Stages ...>::Front&
+Chain<Stages ...>::front() noexcept
+{ return get<0>(); }
+
+template <typename ... Stages>
+Chain<Stages ...>::Back&
+Chain<Stages ...>::back() noexcept
+{ return get<sizeof...(Stages) - 1>(); }
+
+template <typename ... Stages>
+Chain<Stages ...>&
+Chain<Stages ...>::read(void* dest, std::size_t size)
+requires Source<Back>
+{
+	auto* d{static_cast<std::byte*>(dest)};
+	try {
+		while (size) {
+			auto outl{ReadSome(back(), d, size)};
+			d += outl;
+			size -= outl;
+		}
+		return *this;
+	} catch (Input::Exception& exc) {
+		StageAccess::SetUnread(exc, d, size);
+		throw;
+	}
+}
+
+template <typename ... Stages>
+std::size_t
+Chain<Stages ...>::readSome(void* dest, std::size_t size)
+requires Source<Back>
+{ return size ? ReadSome(back(), static_cast<std::byte*>(dest), size) : 0; }
+
+template <typename ... Stages>
+Chain<Stages ...>&
+Chain<Stages ...>::write(void const* src, std::size_t size)
+requires Sink<Back>
+{
+	auto const* s{static_cast<std::byte const*>(src)};
+	try {
+		while (size) {
+			auto inl{WriteSome(back(), s, size)};
+			s += inl;
+			size -= inl;
+		}
+		return *this;
+	} catch (Output::Exception& exc) {
+		StageAccess::SetUnwritten(exc, s, size);
+		throw;
+	}
+}
+
+template <typename ... Stages>
+std::size_t
+Chain<Stages ...>::writeSome(void const* src, std::size_t size)
+requires Sink<Back>
+{ return size ? WriteSome(back(), static_cast<std::byte const*>(src), size) : 0; }
+
+template <typename ... Stages>
+Chain<Stages ...>&
+Chain<Stages ...>::operator>>(auto& t)
+requires Source<Back>
+{
+	if constexpr (std::is_trivially_copyable_v<std::remove_reference_t<decltype(t)>> &&
+		std::is_same_v<decltype(back() >> t), Input&>)
+		return read(&t, sizeof t);
+	else {
+		back() >> t;
+		return *this;
+	}
+}
+
+template <typename ... Stages>
+Chain<Stages ...>&
+Chain<Stages ...>::operator<<(auto const& t)
+requires Sink<Back>
+{
+	if constexpr (std::is_trivially_copyable_v<std::remove_reference_t<decltype(t)>> &&
+		std::is_same_v<decltype(back() << t), Output&>)
+		return write(&t, sizeof t);
+	else {
+		back() << t;
+		return *this;
+	}
+}
+
+}//namespace Stream
@@ -0,0 +1,170 @@
+#include "Stream/Channel.hpp"
+#include <bit>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+
+namespace Stream {
+
+/**
+ * Number of retries that spin before sleeping on the eventfd
+ */
+static constexpr unsigned SpinAttempts{64};
+
+Channel::Channel(std::size_t capacity)
+		: Input{false}
+		, Output{false}
+		, mRing{std::make_unique_for_overwrite<std::byte[]>(std::bit_ceil(capacity))}
+		, mMask{std::bit_ceil(capacity) - 1}
+		, mReadable{::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)}
+		, mWritable{::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)}
+{
+	if (mReadable == -1 || mWritable == -1) {
+		auto const ec{std::make_error_code(static_cast<std::errc>(errno))};
+		if (mReadable != -1)
+			::close(mReadable);
+		if (mWritable != -1)
+			::close(mWritable);
+		throw std::system_error{ec};
+	}
+}
+
+Channel::~Channel()
+{
+	for (auto const descriptor : {mReadable, mWritable})
+		if (::close(descriptor) == -1)
+			LOG_ERR(::strerror(errno));
+}
+
+std::size_t
+Channel::readBytes(std::byte* dest, std::size_t size)
+{
+	auto r{tryReadBytes(dest, size)};
+	if (!r) [[unlikely]]
+		throw Input::Exception{r.error()};
+	return *r;
+}
+
+std::size_t
+Channel::writeBytes(std::byte const* src, std::size_t size)
+{
+	auto r{tryWriteBytes(src, size)};
+	if (!r) [[unlikely]]
+		throw Output::Exception{r.error()};
+	return *r;
+}
+
+std::expected<std::size_t, std::error_code>
+Channel::tryReadBytes(std::byte* dest, std::size_t size)
+{
+	auto const head{mHead.load(std::memory_order_relaxed) & ~Closed};
+	if (head == mCachedTail) { // looks empty, see what the writer has done since
+		auto const tail{mTail.load(std::memory_order_acquire)};
+		mCachedTail = tail & ~Closed;
+		if (head == mCachedTail)
+			return tail & Closed ? std::unexpected{std::make_error_code(std::errc::no_message_available)} : std::expected<std::size_t, std::error_code>{0};
+	}
+
+	size = std::min(size, mCachedTail - head);
+	auto const offset{head & mMask};
+	auto const first{std::min(size, mMask + 1 - offset)}; // up to the end of the ring
+	std::memcpy(dest, mRing.get() + offset, first);
+	std::memcpy(dest + first, mRing.get(), size - first);
+
+	mHead.store(head + size, std::memory_order_release);
+	Wake(mWritable, mWriterSleeping);
+	return size;
+}
+
+std::expected<std::size_t, std::error_code>
+Channel::tryWriteBytes(std::byte const* src, std::size_t size)
+{
+	auto const tail{mTail.load(std::memory_order_relaxed) & ~Closed};
+	auto const capacity{mMask + 1};
+	if (tail - mCachedHead == capacity) { // looks full, see what the reader has done since
+		auto const head{mHead.load(std::memory_order_acquire)};
+		if (head & Closed)
+			return std::unexpected{std::make_error_code(std::errc::broken_pipe)};
+		mCachedHead = head;
+		if (tail - mCachedHead == capacity)
+			return 0;
+	}
+
+	size = std::min(size, capacity - (tail - mCachedHead));
+	auto const offset{tail & mMask};
+	auto const first{std::min(size, capacity - offset)}; // up to the end of the ring
+	std::memcpy(mRing.get() + offset, src, first);
+	std::memcpy(mRing.get(), src + first, size - first);
+
+	mTail.store(tail + size, std::memory_order_release);
+	Wake(mReadable, mReaderSleeping);
+	return size;
+}
+
+std::error_code
+Channel::waitReadable(unsigned attempt) noexcept
+{
+	if (attempt < SpinAttempts) // the writer is likely to be in the middle of a copy
+		return Interrupt::Check();
+	return Sleep(mReadable, mReaderSleeping, [this] {
+		auto const tail{mTail.load(std::memory_order_acquire)};
+		return (tail & Closed) || tail != (mHead.load(std::memory_order_relaxed) & ~Closed);
+	});
+}
+
+std::error_code
+Channel::waitWritable(unsigned attempt) noexcept
+{
+	if (attempt < SpinAttempts) // the reader is likely to be in the middle of a copy
+		return Interrupt::Check();
+	return Sleep(mWritable, mWriterSleeping, [this] {
+		auto const head{mHead.load(std::memory_order_acquire)};
+		return (head & Closed) || (mTail.load(std::memory_order_relaxed) & ~Closed) - head != mMask + 1;
+	});
+}
+
+std::error_code
+Channel::Sleep(int const descriptor, std::atomic<bool>& sleeping, auto&& ready) noexcept
+{
+	if (auto ec{Interrupt::Check()})
+		return ec;
+	sleeping.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst); // pairs with the one in Wake(), one side sees the other
+	std::error_code ec;
+	if (!ready())
+		ec = Poll(descriptor, POLLIN);
+	sleeping.store(false, std::memory_order_relaxed);
+	::eventfd_t count;
+	::eventfd_read(descriptor, &count); // a wakeup that came too late only makes the next sleep return early
+	return ec ? ec : Interrupt::Check();
+}
+
+void
+Channel::Wake(int const descriptor, std::atomic<bool> const& sleeping) noexcept
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (sleeping.load(std::memory_order_relaxed))
+		::eventfd_write(descriptor, 1);
+}
+
+void
+Channel::closeOutput() noexcept
+{
+	mTail.fetch_or(Closed, std::memory_order_release);
+	Wake(mReadable, mReaderSleeping);
+}
+
+void
+Channel::closeInput() noexcept
+{
+	mHead.fetch_or(Closed, std::memory_order_release);
+	Wake(mWritable, mWriterSleeping);
+}
+
+std::size_t
+Channel::getCapacity() const noexcept
+{ return mMask + 1; }
+
+}//namespace Stream
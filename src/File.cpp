@@ -1,5 +1,8 @@
 #include "Stream/File.hpp"
+#include <climits>
+#include <cstdio>
 #include <cstring>
+#include <poll.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -12,13 +15,33 @@ File::File(int descriptor) noexcept
 		, mDescriptor{descriptor}
 {}
 
+/**
+ * Do @p transfer at the file offset of @p direct through @p buffered and move the offset of @p direct past it
+ * @details	The offset is kept by @p direct, so the descriptors can take turns. An appending write lands at the end
+ *			through either descriptor.
+ */
+static ::ssize_t
+Buffered(int direct, int buffered, auto&& transfer) noexcept
+{
+	auto const offset{::lseek(direct, 0, SEEK_CUR)};
+	if (offset == -1)
+		return -1;
+	auto const r{transfer(buffered, offset)};
+	if (r > 0) {
+		auto const append{(::fcntl(direct, F_GETFL) & O_APPEND) != 0};
+		if (::lseek(direct, append ? 0 : offset + r, append ? SEEK_END : SEEK_SET) == -1)
+			return -1;
+	}
+	return r;
+}
+
 /**
  * @see		<a href="https://man7.org/linux/man-pages/man2/open.2.html">open()</a>
- * @details	Creates a file resource with given @p name and open @p mode.
+ * @details	Creates a file resource with given @p name, open @p mode and @p caching.
  *			If <b>open()</b> system call fails, it throws a File::Exception.
  */
-File::File(std::string const& name, Mode mode)
-		: File{::open(name.c_str(), static_cast<int>(mode), S_IWUSR | S_IRUSR | S_IRGRP | S_IROTH)}
+File::File(std::string const& name, Mode mode, Caching caching)
+		: File{::open(name.c_str(), static_cast<int>(mode) | static_cast<int>(caching), S_IWUSR | S_IRUSR | S_IRGRP | S_IROTH)}
 {
 	if (mDescriptor == -1)
 		throw File::Exception{std::make_error_code(static_cast<std::errc>(errno)), name};
@@ -32,7 +55,10 @@ File::File(File&& other) noexcept
 
 void
 swap(File& a, File& b) noexcept
-{ std::swap(a.mDescriptor, b.mDescriptor); }
+{
+	std::swap(a.mDescriptor, b.mDescriptor);
+	std::swap(a.mBufferedDescriptor, b.mBufferedDescriptor);
+}
 
 File&
 File::operator=(File&& other) noexcept
@@ -56,39 +82,146 @@ File::~File()
 		if (::close(mDescriptor) == -1)
 			LOG_ERR(::strerror(errno));
 	}
+	if (mBufferedDescriptor != -1 && ::close(mBufferedDescriptor) == -1)
+		LOG_ERR(::strerror(errno));
+}
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man5/proc_pid_fd.5.html">/proc/pid/fd</a>
+ */
+int
+File::getBufferedDescriptor() noexcept
+{
+	if (mBufferedDescriptor != -1)
+		return mBufferedDescriptor;
+
+	auto const flags{::fcntl(mDescriptor, F_GETFL)};
+	if (flags == -1 || !(flags & O_DIRECT)) {
+		errno = EINVAL;
+		return -1;
+	}
+	char path[32];
+	std::snprintf(path, sizeof path, "/proc/self/fd/%d", mDescriptor);
+	return mBufferedDescriptor = ::open(path, (flags & (O_ACCMODE | O_APPEND)) | O_CLOEXEC);
 }
 
 std::size_t
 File::readBytes(std::byte* dest, std::size_t size)
+{
+	auto r{tryReadBytes(dest, size)};
+	if (!r) [[unlikely]]
+		throw Input::Exception{r.error()};
+	return *r;
+}
+
+std::size_t
+File::writeBytes(std::byte const* src, std::size_t size)
+{
+	auto r{tryWriteBytes(src, size)};
+	if (!r) [[unlikely]]
+		throw Output::Exception{r.error()};
+	return *r;
+}
+
+std::size_t
+File::readVector(std::span<::iovec const> iov)
 {
 	while (true) {
-		auto r{::read(mDescriptor, dest, size)};
+		getInputProbe().syscall();
+		auto const count{static_cast<int>(std::min<std::size_t>(iov.size(), IOV_MAX))};
+		auto r{::readv(mDescriptor, iov.data(), count)};
+		if (r == -1 && errno == EINVAL) // unaligned part of a direct transfer
+			if (auto const buffered{getBufferedDescriptor()}; buffered != -1)
+				r = Buffered(mDescriptor, buffered, [&](int fd, ::off_t offset) { return ::preadv(fd, iov.data(), count, offset); });
 		if (r > 0)
 			return r;
 		if (r == 0)
 			throw Input::Exception{std::make_error_code(std::errc::no_message_available)};
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
 		if (errno != EINTR)
 			throw Input::Exception{std::make_error_code(static_cast<std::errc>(errno))};
 	}
 }
 
 std::size_t
-File::writeBytes(std::byte const* src, std::size_t size)
+File::writeVector(std::span<::iovec const> iov)
 {
 	while (true) {
-		if (auto r{::write(mDescriptor, src, size)}; r >= 0)
+		getOutputProbe().syscall();
+		auto const count{static_cast<int>(std::min<std::size_t>(iov.size(), IOV_MAX))};
+		auto r{::writev(mDescriptor, iov.data(), count)};
+		if (r == -1 && errno == EINVAL) // unaligned part of a direct transfer
+			if (auto const buffered{getBufferedDescriptor()}; buffered != -1)
+				r = Buffered(mDescriptor, buffered, [&](int fd, ::off_t offset) { return ::pwritev(fd, iov.data(), count, offset); });
+		if (r >= 0)
 			return r;
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
 		if (errno != EINTR)
 			throw Output::Exception{std::make_error_code(static_cast<std::errc>(errno))};
 	}
 }
 
+std::expected<std::size_t, std::error_code>
+File::tryReadBytes(std::byte* dest, std::size_t size)
+{
+	while (true) {
+		getInputProbe().syscall();
+		auto r{::read(mDescriptor, dest, size)};
+		if (r == -1 && errno == EINVAL) // unaligned part of a direct transfer
+			if (auto const buffered{getBufferedDescriptor()}; buffered != -1)
+				r = Buffered(mDescriptor, buffered, [&](int fd, ::off_t offset) { return ::pread(fd, dest, size, offset); });
+		if (r > 0)
+			return r;
+		if (r == 0)
+			return std::unexpected{std::make_error_code(std::errc::no_message_available)};
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
+		if (errno != EINTR)
+			return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
+	}
+}
+
+std::expected<std::size_t, std::error_code>
+File::tryWriteBytes(std::byte const* src, std::size_t size)
+{
+	while (true) {
+		getOutputProbe().syscall();
+		auto r{::write(mDescriptor, src, size)};
+		if (r == -1 && errno == EINVAL) // unaligned part of a direct transfer
+			if (auto const buffered{getBufferedDescriptor()}; buffered != -1)
+				r = Buffered(mDescriptor, buffered, [&](int fd, ::off_t offset) { return ::pwrite(fd, src, size, offset); });
+		if (r >= 0)
+			return r;
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
+		if (errno != EINTR)
+			return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
+	}
+}
+
+std::error_code
+File::waitReadable(unsigned) noexcept
+{
+	getInputProbe().syscall();
+	return Poll(mDescriptor, POLLIN);
+}
+
+std::error_code
+File::waitWritable(unsigned) noexcept
+{
+	getOutputProbe().syscall();
+	return Poll(mDescriptor, POLLOUT);
+}
+
 /**
  * @see		<a href="https://man7.org/linux/man-pages/man2/fdatasync.2.html">fdatasync()</a>
  */
 void
 File::flush()
 {
+	getOutputProbe().syscall();
 	if (::fdatasync(mDescriptor) == -1)
 		throw Output::Exception{std::make_error_code(static_cast<std::errc>(errno))};
 }
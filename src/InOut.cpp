@@ -1,13 +1,172 @@
 #include "Stream/InOut.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <thread>
 #include <unistd.h>
 
 
 namespace Stream {
 
+/**
+ * Skip @p size bytes of @p iov whose first area is already processed up to @p offset
+ */
+static void
+Advance(std::span<::iovec const>& iov, std::size_t& offset, std::size_t size) noexcept
+{
+	offset += size;
+	while (!iov.empty() && offset >= iov.front().iov_len) {
+		offset -= iov.front().iov_len;
+		iov = iov.subspan(1);
+	}
+}
+
+static std::size_t
+Remaining(std::span<::iovec const> iov, std::size_t offset) noexcept
+{
+	std::size_t size{0};
+	for (auto const& v : iov)
+		size += v.iov_len;
+	return size - offset;
+}
+
+void
+Backoff::operator()(unsigned attempt) const noexcept
+{
+	if (attempt < spins) {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#endif
+		return;
+	}
+	if ((attempt -= spins) < yields) {
+		std::this_thread::yield();
+		return;
+	}
+	auto const shift{std::min(attempt - yields, 16u)};
+	std::this_thread::sleep_for(std::min(minSleep * (1u << shift), maxSleep));
+}
+
+static thread_local Interrupt const* Installed{nullptr};
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/eventfd.2.html">eventfd()</a>
+ */
+Interrupt::Interrupt()
+		: mDescriptor{::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)}
+{
+	if (mDescriptor == -1)
+		throw std::system_error{std::make_error_code(static_cast<std::errc>(errno))};
+}
+
+Interrupt::~Interrupt()
+{
+	if (::close(mDescriptor) == -1)
+		LOG_ERR(::strerror(errno));
+}
+
+void
+Interrupt::trigger() noexcept
+{
+	mTriggered.store(true, std::memory_order_release);
+	::eventfd_write(mDescriptor, 1);
+}
+
+void
+Interrupt::Install(Interrupt const* interrupt) noexcept
+{ Installed = interrupt; }
+
+std::error_code
+Interrupt::Check() noexcept
+{
+	return Installed && Installed->mTriggered.load(std::memory_order_acquire)
+		? std::make_error_code(std::errc::operation_canceled)
+		: std::error_code{};
+}
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/poll.2.html">poll()</a>
+ */
+std::error_code
+Poll(int descriptor, short events) noexcept
+{
+	// a negative descriptor is ignored, as is the interrupt when none is installed
+	::pollfd fds[]{{descriptor, events, 0}, {Installed ? Installed->mDescriptor : -1, POLLIN, 0}};
+	while (::poll(fds, 2, -1) == -1)
+		if (errno != EINTR)
+			return std::make_error_code(static_cast<std::errc>(errno));
+	return Interrupt::Check();
+}
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/fcntl.2.html">fcntl()</a>
+ */
+bool
+IsNonBlocking(int descriptor) noexcept
+{
+	auto const error{errno};
+	auto const flags{::fcntl(descriptor, F_GETFL)};
+	errno = error;
+	return flags != -1 && (flags & O_NONBLOCK);
+}
+
 Input::Input(bool allowLink) noexcept
 		: mSource{allowLink ? Input::Unreadable : nullptr}
 {}
 
+std::size_t
+Input::readAvailable(std::byte* dest, std::size_t size)
+{
+	std::size_t outl;
+	for (unsigned attempt{0}; !(outl = mProbe.measure([&] { return readBytes(dest, size); })); ++attempt) {
+		mProbe.wait();
+		if (auto ec{waitReadable(attempt)})
+			throw Input::Exception{ec};
+	}
+	return outl;
+}
+
+std::size_t
+Input::readVectorAvailable(std::span<::iovec const> iov)
+{
+	std::size_t outl;
+	for (unsigned attempt{0}; !(outl = mProbe.measure([&] { return readVector(iov); })); ++attempt) {
+		mProbe.wait();
+		if (auto ec{waitReadable(attempt)})
+			throw Input::Exception{ec};
+	}
+	return outl;
+}
+
+std::size_t
+Input::readVector(std::span<::iovec const> iov)
+{
+	for (auto const& v : iov)
+		if (v.iov_len)
+			return readBytes(static_cast<std::byte*>(v.iov_base), v.iov_len);
+	return 0;
+}
+
+std::expected<std::size_t, std::error_code>
+Input::tryReadBytes(std::byte* dest, std::size_t size)
+{
+	try {
+		return readBytes(dest, size);
+	} catch (Input::Exception const& exc) {
+		return std::unexpected{exc.code()};
+	}
+}
+
+std::error_code
+Input::waitReadable(unsigned attempt) noexcept
+{
+	if (mSource && mSource != Input::Unreadable && mSource != this)
+		return getSource().waitReadable(attempt);
+	DefaultBackoff(attempt);
+	return Interrupt::Check();
+}
+
 void
 Input::drain()
 {}
@@ -16,6 +175,10 @@ Input&
 Input::getSource() noexcept
 { return *mSource; }
 
+Probe&
+Input::getInputProbe() noexcept
+{ return mProbe; }
+
 Input::Input(Input&& other) noexcept
 		: Input()
 { swap(*this, other); }
@@ -34,6 +197,7 @@ Input::operator=(Input&& other) noexcept
 Input&
 Input::operator>>(std::nullptr_t)
 {
+	[[maybe_unused]] auto timer{mProbe.timeFlush()};
 	drain();
 	return *this;
 }
@@ -45,6 +209,7 @@ Input::operator>(std::nullptr_t)
 	// do not trigger the mSource if it is unreadable to avoid infinite recursion
 	if (mSource && mSource != Input::Unreadable)
 		getSource() > nullptr;
+	[[maybe_unused]] auto timer{mProbe.timeFlush()};
 	drain();
 	return *this;
 }
@@ -54,8 +219,7 @@ Input::read(void* dest, std::size_t size)
 {
 	try {
 		while (size) {
-			std::size_t outl;
-			while (!(outl = readBytes(reinterpret_cast<std::byte*>(dest), size)));
+			auto outl{readAvailable(reinterpret_cast<std::byte*>(dest), size)};
 			reinterpret_cast<std::byte*&>(dest) += outl;
 			size -= outl;
 		}
@@ -70,10 +234,75 @@ Input::read(void* dest, std::size_t size)
 std::size_t
 Input::readSome(void* dest, std::size_t size)
 {
-	std::size_t outl{0};
+	return size ? readAvailable(reinterpret_cast<std::byte*>(dest), size) : 0;
+}
+
+Input&
+Input::read(std::span<::iovec const> iov)
+{
+	std::size_t offset{0};
+	Advance(iov, offset, 0);
+	try {
+		while (!iov.empty()) {
+			std::size_t outl;
+			if (offset) // continue the partially read area on its own
+				outl = readAvailable(static_cast<std::byte*>(iov.front().iov_base) + offset, iov.front().iov_len - offset);
+			else
+				outl = readVectorAvailable(iov);
+			Advance(iov, offset, outl);
+		}
+		return *this;
+	} catch (Input::Exception& exc) {
+		exc.mDest = static_cast<std::byte*>(iov.front().iov_base) + offset;
+		exc.mSize = Remaining(iov, offset);
+		throw;
+	}
+}
+
+std::size_t
+Input::readSome(std::span<::iovec const> iov)
+{
+	std::size_t offset{0};
+	Advance(iov, offset, 0);
+	return iov.empty() ? 0 : readVectorAvailable(iov);
+}
+
+std::expected<std::size_t, std::error_code>
+Input::tryRead(void* dest, std::size_t const size)
+{
+	std::size_t total{0};
+	while (total < size) {
+		auto r{tryReadSome(static_cast<std::byte*>(dest) + total, size - total)};
+		if (!r)
+			return total ? total : r;
+		total += *r;
+	}
+	return total;
+}
+
+std::expected<std::size_t, std::error_code>
+Input::TryReadBytes(Input& source, std::byte* dest, std::size_t size)
+{ return source.mProbe.measure([&] { return source.tryReadBytes(dest, size); }); }
+
+std::error_code
+Input::WaitReadable(Input& source, unsigned attempt) noexcept
+{
+	source.mProbe.wait();
+	return source.waitReadable(attempt);
+}
+
+std::expected<std::size_t, std::error_code>
+Input::tryReadSome(void* dest, std::size_t const size)
+{
 	if (size)
-		while (!(outl = readBytes(reinterpret_cast<std::byte*>(dest), size)));
-	return outl;
+		for (unsigned attempt{0};; ++attempt) {
+			if (auto r{mProbe.measure([&] { return tryReadBytes(static_cast<std::byte*>(dest), size); })}; !r || *r)
+				return r;
+			mProbe.wait();
+			if (auto ec{waitReadable(attempt)})
+				return std::unexpected{ec};
+		}
+	return 0;
 }
 
 void*
@@ -91,6 +320,10 @@ static class : public Input {
 	readBytes(std::byte* dest, std::size_t size) override
 	{ throw Input::Exception{std::make_error_code(std::errc::no_message_available)}; }
 
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) override
+	{ return std::unexpected{std::make_error_code(std::errc::no_message_available)}; }
+
 } unreadable;
 Input* Input::Unreadable = &unreadable;
 
@@ -99,18 +332,37 @@ static class : public Input {
 
 	std::size_t
 	readBytes(std::byte* dest, std::size_t size) override
+	{
+		auto r{tryReadBytes(dest, size)};
+		if (!r) [[unlikely]]
+			throw Input::Exception{r.error()};
+		return *r;
+	}
+
+	std::expected<std::size_t, std::error_code>
+	tryReadBytes(std::byte* dest, std::size_t size) override
 	{
 		while (true) {
+			getInputProbe().syscall();
 			auto r{::read(STDIN_FILENO, dest, size)};
 			if (r > 0)
 				return r;
 			if (r == 0)
-				throw Input::Exception{std::make_error_code(std::errc::no_message_available)};
+				return std::unexpected{std::make_error_code(std::errc::no_message_available)};
+			if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(STDIN_FILENO)) // wait before retrying, a blocking one timed out
+				return 0;
 			if (errno != EINTR)
-				throw Input::Exception{std::make_error_code(static_cast<std::errc>(errno))};
+				return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
 		}
 	}
 
+	std::error_code
+	waitReadable(unsigned) noexcept override
+	{
+		getInputProbe().syscall();
+		return Poll(STDIN_FILENO, POLLIN);
+	}
+
 } stdIn;
 Input& StdIn = stdIn;
 
@@ -119,6 +371,70 @@ Output::Output(bool allowLink) noexcept
 		: mSink{allowLink ? Output::Unwritable : nullptr}
 {}
 
+std::size_t
+Output::writeAvailable(std::byte const* src, std::size_t size)
+{
+	std::size_t inl;
+	for (unsigned attempt{0}; !(inl = mProbe.measure([&] { return writeBytes(src, size); })); ++attempt) {
+		mProbe.wait();
+		if (auto ec{waitWritable(attempt)})
+			throw Output::Exception{ec};
+	}
+	return inl;
+}
+
+std::size_t
+Output::WriteBytes(Output& sink, std::byte const* src, std::size_t size)
+{ return sink.mProbe.measure([&] { return sink.writeBytes(src, size); }); }
+
+std::size_t
+Output::WriteVector(Output& sink, std::span<::iovec const> iov)
+{ return sink.mProbe.measure([&] { return sink.writeVector(iov); }); }
+
+std::size_t
+Output::WriteAvailable(Output& sink, std::byte const* src, std::size_t size)
+{ return sink.writeAvailable(src, size); }
+
+std::size_t
+Output::writeVectorAvailable(std::span<::iovec const> iov)
+{
+	std::size_t inl;
+	for (unsigned attempt{0}; !(inl = mProbe.measure([&] { return writeVector(iov); })); ++attempt) {
+		mProbe.wait();
+		if (auto ec{waitWritable(attempt)})
+			throw Output::Exception{ec};
+	}
+	return inl;
+}
+
+std::size_t
+Output::writeVector(std::span<::iovec const> iov)
+{
+	for (auto const& v : iov)
+		if (v.iov_len)
+			return writeBytes(static_cast<std::byte const*>(v.iov_base), v.iov_len);
+	return 0;
+}
+
+std::expected<std::size_t, std::error_code>
+Output::tryWriteBytes(std::byte const* src, std::size_t size)
+{
+	try {
+		return writeBytes(src, size);
+	} catch (Output::Exception const& exc) {
+		return std::unexpected{exc.code()};
+	}
+}
+
+std::error_code
+Output::waitWritable(unsigned attempt) noexcept
+{
+	if (mSink && mSink != Output::Unwritable && mSink != this)
+		return getSink().waitWritable(attempt);
+	DefaultBackoff(attempt);
+	return Interrupt::Check();
+}
+
 void
 Output::flush()
 {}
@@ -127,6 +443,10 @@ Output&
 Output::getSink() noexcept
 { return *mSink; }
 
+Probe&
+Output::getOutputProbe() noexcept
+{ return mProbe; }
+
 Output::Output(Output&& other) noexcept
 		: Output{}
 { swap(*this, other); }
@@ -145,6 +465,7 @@ Output::operator=(Output&& other) noexcept
 Output&
 Output::operator<<(std::nullptr_t)
 {
+	[[maybe_unused]] auto timer{mProbe.timeFlush()};
 	flush();
 	return *this;
 }
@@ -152,7 +473,10 @@ Output::operator<<(std::nullptr_t)
 Output&
 Output::operator<(std::nullptr_t)
 {
-	flush();
+	{
+		[[maybe_unused]] auto timer{mProbe.timeFlush()};
+		flush();
+	}
 	// subclass can explicitly disallow linking to another sink
 	// do not trigger the mSink if it is unwritable to avoid infinite recursion
 	if (mSink && mSink != Output::Unwritable)
@@ -165,8 +489,7 @@ Output::write(void const* src, std::size_t size)
 {
 	try {
 		while (size) {
-			std::size_t inl;
-			while (!(inl = writeBytes(reinterpret_cast<std::byte const*>(src), size)));
+			auto inl{writeAvailable(reinterpret_cast<std::byte const*>(src), size)};
 			reinterpret_cast<std::byte const*&>(src) += inl;
 			size -= inl;
 		}
@@ -181,10 +504,64 @@ Output::write(void const* src, std::size_t size)
 std::size_t
 Output::writeSome(void const* src, std::size_t size)
 {
-	std::size_t inl{0};
+	return size ? writeAvailable(reinterpret_cast<std::byte const*>(src), size) : 0;
+}
+
+Output&
+Output::write(std::span<::iovec const> iov)
+{
+	std::size_t offset{0};
+	Advance(iov, offset, 0);
+	try {
+		while (!iov.empty()) {
+			std::size_t inl;
+			if (offset) // continue the partially written area on its own
+				inl = writeAvailable(static_cast<std::byte const*>(iov.front().iov_base) + offset, iov.front().iov_len - offset);
+			else
+				inl = writeVectorAvailable(iov);
+			Advance(iov, offset, inl);
+		}
+		return *this;
+	} catch (Output::Exception& exc) {
+		exc.mSrc = static_cast<std::byte const*>(iov.front().iov_base) + offset;
+		exc.mSize = Remaining(iov, offset);
+		throw;
+	}
+}
+
+std::size_t
+Output::writeSome(std::span<::iovec const> iov)
+{
+	std::size_t offset{0};
+	Advance(iov, offset, 0);
+	return iov.empty() ? 0 : writeVectorAvailable(iov);
+}
+
+std::expected<std::size_t, std::error_code>
+Output::tryWrite(void const* src, std::size_t const size)
+{
+	std::size_t total{0};
+	while (total < size) {
+		auto r{tryWriteSome(static_cast<std::byte const*>(src) + total, size - total)};
+		if (!r)
+			return total ? total : r;
+		total += *r;
+	}
+	return total;
+}
+
+std::expected<std::size_t, std::error_code>
+Output::tryWriteSome(void const* src, std::size_t const size)
+{
 	if (size)
-		while (!(inl = writeBytes(reinterpret_cast<std::byte const*>(src), size)));
-	return inl;
+		for (unsigned attempt{0};; ++attempt) {
+			if (auto r{mProbe.measure([&] { return tryWriteBytes(static_cast<std::byte const*>(src), size); })}; !r || *r)
+				return r;
+			mProbe.wait();
+			if (auto ec{waitWritable(attempt)})
+				return std::unexpected{ec};
+		}
+	return 0;
 }
 
 void const*
@@ -202,6 +579,10 @@ static class : public Output {
 	writeBytes(std::byte const* src, std::size_t size) override
 	{ throw Output::Exception{std::make_error_code(std::errc::no_space_on_device)}; }
 
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) override
+	{ return std::unexpected{std::make_error_code(std::errc::no_space_on_device)}; }
+
 } unwritable;
 Output* Output::Unwritable = &unwritable;
 
@@ -210,15 +591,34 @@ static class : public Output {
 
 	std::size_t
 	writeBytes(std::byte const* src, std::size_t size) override
+	{
+		auto r{tryWriteBytes(src, size)};
+		if (!r) [[unlikely]]
+			throw Output::Exception{r.error()};
+		return *r;
+	}
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) override
 	{
 		while (true) {
+			getOutputProbe().syscall();
 			if (auto r{::write(STDOUT_FILENO, src, size)}; r >= 0)
 				return r;
+			if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(STDOUT_FILENO)) // wait before retrying, a blocking one timed out
+				return 0;
 			if (errno != EINTR)
-				throw Output::Exception{std::make_error_code(static_cast<std::errc>(errno))};
+				return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
 		}
 	}
 
+	std::error_code
+	waitWritable(unsigned) noexcept override
+	{
+		getOutputProbe().syscall();
+		return Poll(STDOUT_FILENO, POLLOUT);
+	}
+
 } stdOut;
 Output& StdOut = stdOut;
 
@@ -227,15 +627,34 @@ static class : public Output {
 
 	std::size_t
 	writeBytes(std::byte const* src, std::size_t size) override
+	{
+		auto r{tryWriteBytes(src, size)};
+		if (!r) [[unlikely]]
+			throw Output::Exception{r.error()};
+		return *r;
+	}
+
+	std::expected<std::size_t, std::error_code>
+	tryWriteBytes(std::byte const* src, std::size_t size) override
 	{
 		while (true) {
+			getOutputProbe().syscall();
 			if (auto r{::write(STDERR_FILENO, src, size)}; r >= 0)
 				return r;
+			if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(STDERR_FILENO)) // wait before retrying, a blocking one timed out
+				return 0;
 			if (errno != EINTR)
-				throw Output::Exception{std::make_error_code(static_cast<std::errc>(errno))};
+				return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
 		}
 	}
 
+	std::error_code
+	waitWritable(unsigned) noexcept override
+	{
+		getOutputProbe().syscall();
+		return Poll(STDERR_FILENO, POLLOUT);
+	}
+
 } stdErr;
 Output& StdErr = stdErr;
 
@@ -132,7 +132,11 @@ Output&
 Output::operator<<(std::basic_string<C> const& s)
 {
 	std::uint64_t size{s.size()};
-	return write(&size, sizeof size).write(s.data(), size * sizeof(C));
+	::iovec const iov[]{
+		{&size, sizeof size},
+		{const_cast<C*>(s.data()), size * sizeof(C)}
+	};
+	return write(iov);
 }
 
 Output&
@@ -140,7 +144,11 @@ Output::operator<<(Char auto const* s)
 {
 	using C = std::remove_pointer_t<decltype(s)>;
 	std::uint64_t size{std::char_traits<C>::length(s)};
-	return write(&size, sizeof size).write(s, size * sizeof(C));
+	::iovec const iov[]{
+		{&size, sizeof size},
+		{const_cast<void*>(static_cast<void const*>(s)), size * sizeof(C)}
+	};
+	return write(iov);
 }
 
 
@@ -207,6 +215,50 @@ requires (std::derived_from<T, Input> && std::derived_from<T, Output>)
 	return inputOutput;
 }
 
+template <typename S>
+std::size_t
+StageAccess::ReadBytes(S& source, std::byte* dest, std::size_t size)
+{ return source.S::readBytes(dest, size); }
+
+template <typename S>
+std::expected<std::size_t, std::error_code>
+StageAccess::TryReadBytes(S& source, std::byte* dest, std::size_t size)
+{ return source.S::tryReadBytes(dest, size); }
+
+template <typename S>
+std::error_code
+StageAccess::WaitReadable(S& source, unsigned attempt) noexcept
+{ return source.S::waitReadable(attempt); }
+
+template <typename S>
+std::size_t
+StageAccess::WriteBytes(S& sink, std::byte const* src, std::size_t size)
+{ return sink.S::writeBytes(src, size); }
+
+template <typename S>
+std::expected<std::size_t, std::error_code>
+StageAccess::TryWriteBytes(S& sink, std::byte const* src, std::size_t size)
+{ return sink.S::tryWriteBytes(src, size); }
+
+template <typename S>
+std::error_code
+StageAccess::WaitWritable(S& sink, unsigned attempt) noexcept
+{ return sink.S::waitWritable(attempt); }
+
+inline void
+StageAccess::SetUnread(Input::Exception& exc, void* dest, std::size_t size) noexcept
+{
+	exc.mDest = dest;
+	exc.mSize = size;
+}
+
+inline void
+StageAccess::SetUnwritten(Output::Exception& exc, void const* src, std::size_t size) noexcept
+{
+	exc.mSrc = src;
+	exc.mSize = size;
+}
+
 #if defined (NDEBUG)
 #	define LOG_ERR(err) try { Stream::StdErr << __PRETTY_FUNCTION__ << ' ' << err << '\n'; } catch (...) {}
 #else
@@ -0,0 +1,242 @@
+#include "Stream/MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+
+namespace Stream {
+
+static std::size_t const PageSize{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/mmap.2.html">mmap()</a>
+ * @see		<a href="https://man7.org/linux/man-pages/man2/madvise.2.html">madvise()</a>
+ */
+MappedFile::MappedFile(std::string const& name, std::size_t windowSize)
+		: mDescriptor{::open(name.c_str(), O_RDONLY | O_CLOEXEC)}
+		, mWindowSize{windowSize ? ::ceilz(windowSize, PageSize) * PageSize : 0}
+{
+	if (mDescriptor == -1)
+		throw Exception{std::make_error_code(static_cast<std::errc>(errno)), name};
+
+	struct stat fileStatus;
+	if (::fstat(mDescriptor, &fileStatus) == -1) {
+		auto const ec{std::make_error_code(static_cast<std::errc>(errno))};
+		release();
+		throw Exception{ec, name};
+	}
+	mFileSize = fileStatus.st_size;
+	::posix_fadvise(mDescriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+	if (mFileSize)
+		if (auto ec{map(0, mWindowSize ? mWindowSize : static_cast<std::size_t>(mFileSize))}) {
+			release();
+			throw Exception{ec, name};
+		}
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{ swap(*this, other); }
+
+void
+swap(MappedFile& a, MappedFile& b) noexcept
+{
+	swap(static_cast<BufferInput&>(a), static_cast<BufferInput&>(b));
+	std::swap(a.mDescriptor, b.mDescriptor);
+	std::swap(a.mMap, b.mMap);
+	std::swap(a.mMapSize, b.mMapSize);
+	std::swap(a.mMapOffset, b.mMapOffset);
+	std::swap(a.mFileSize, b.mFileSize);
+	std::swap(a.mWindowSize, b.mWindowSize);
+}
+
+MappedFile&
+MappedFile::operator=(MappedFile&& other) noexcept
+{
+	swap(*this, other);
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{ release(); }
+
+std::expected<std::size_t, std::error_code>
+MappedFile::tryProvideBytes(std::size_t const size)
+{
+	auto const offset{mMapOffset + (mInputDataBeg - mMap)};
+	if (offset + static_cast<::off_t>(getDataSize()) >= mFileSize) // everything is mapped already
+		return std::unexpected{std::make_error_code(std::errc::no_message_available)};
+
+	if (auto ec{map(offset, std::max(size, mWindowSize))})
+		return std::unexpected{ec};
+	return std::min(size, getDataSize());
+}
+
+std::error_code
+MappedFile::map(::off_t const offset, std::size_t const size) noexcept
+{
+	auto const mapOffset{offset - offset % static_cast<::off_t>(PageSize)};
+	auto const mapSize{std::min(
+		static_cast<std::size_t>(offset - mapOffset) + size,
+		static_cast<std::size_t>(mFileSize - mapOffset)
+	)};
+
+	auto* map{::mmap(nullptr, mapSize, PROT_READ, MAP_SHARED, mDescriptor, mapOffset)};
+	if (map == MAP_FAILED)
+		return std::make_error_code(static_cast<std::errc>(errno));
+	::madvise(map, mapSize, MADV_SEQUENTIAL);
+	::madvise(map, mapSize, MADV_WILLNEED);
+
+	if (mMap)
+		::munmap(mMap, mMapSize);
+	mMap = static_cast<std::byte*>(map);
+	mMapSize = mapSize;
+	mMapOffset = mapOffset;
+	mInputDataBeg = mMap + (offset - mapOffset);
+	mInputDataEnd = mMap + mapSize;
+	mInputEnd = mInputDataEnd;
+	return {};
+}
+
+void
+MappedFile::release() noexcept
+{
+	if (mMap)
+		::munmap(mMap, mMapSize);
+	if (mDescriptor != -1)
+		::close(mDescriptor);
+	mMap = nullptr;
+	mDescriptor = -1;
+}
+
+::off_t
+MappedFile::getFileSize() const noexcept
+{ return mFileSize; }
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/fallocate.2.html">fallocate()</a>
+ * @see		<a href="https://man7.org/linux/man-pages/man2/mremap.2.html">mremap()</a>
+ */
+MappedFileOutput::MappedFileOutput(std::string const& name, std::size_t initialSize)
+		: mDescriptor{::open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IWUSR | S_IRUSR | S_IRGRP | S_IROTH)}
+{
+	if (mDescriptor == -1)
+		throw Exception{std::make_error_code(static_cast<std::errc>(errno)), name};
+
+	if (auto ec{grow(::ceilz(initialSize, PageSize) * PageSize)}) {
+		::close(mDescriptor);
+		throw Exception{ec, name};
+	}
+}
+
+MappedFileOutput::MappedFileOutput(MappedFileOutput&& other) noexcept
+{ swap(*this, other); }
+
+void
+swap(MappedFileOutput& a, MappedFileOutput& b) noexcept
+{
+	swap(static_cast<BufferOutput&>(a), static_cast<BufferOutput&>(b));
+	std::swap(a.mDescriptor, b.mDescriptor);
+	std::swap(a.mMap, b.mMap);
+	std::swap(a.mMapSize, b.mMapSize);
+}
+
+MappedFileOutput&
+MappedFileOutput::operator=(MappedFileOutput&& other) noexcept
+{
+	swap(*this, other);
+	return *this;
+}
+
+MappedFileOutput::~MappedFileOutput()
+{
+	try {
+		close();
+	} catch (Output::Exception const& exc) {
+		// Nothing can be done
+		LOG_ERR(exc.what())
+	}
+}
+
+std::expected<std::size_t, std::error_code>
+MappedFileOutput::tryAllocBytes(std::size_t const size)
+{
+	auto const dataSize{static_cast<std::size_t>(mOutputDataEnd - mMap)};
+	if (dataSize + size > mMapSize) {
+		auto const capacity{mOutputPolicy.grow(mMapSize, dataSize + size)};
+		if (!capacity) [[unlikely]] // beyond the maxSize of the policy
+			return std::unexpected{make_error_code(Buffer::Exception::Code::BadAllocation)};
+		if (auto ec{grow(::ceilz(capacity, PageSize) * PageSize)})
+			return std::unexpected{ec};
+	}
+	return std::min(size, static_cast<std::size_t>(mOutputEnd - mOutputDataEnd));
+}
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/msync.2.html">msync()</a>
+ */
+void
+MappedFileOutput::flush()
+{
+	if (!mMap)
+		return;
+	auto const offset{static_cast<std::size_t>(mOutputDataBeg - mMap) / PageSize * PageSize};
+	auto const size{static_cast<std::size_t>(mOutputDataEnd - mMap) - offset};
+	if (size && ::msync(mMap + offset, size, MS_SYNC) == -1)
+		throw Output::Exception{std::make_error_code(static_cast<std::errc>(errno))};
+	mOutputDataBeg = mOutputDataEnd;
+}
+
+std::error_code
+MappedFileOutput::grow(std::size_t const size) noexcept
+{
+	// reserve the blocks, so that running out of space is an error here instead of a SIGBUS on a later store
+	if (::fallocate(mDescriptor, 0, mMapSize, size - mMapSize) == -1 &&
+		(errno != EOPNOTSUPP || ::ftruncate(mDescriptor, size) == -1)
+	)
+		return std::make_error_code(static_cast<std::errc>(errno));
+
+	auto* map{mMap ?
+		::mremap(mMap, mMapSize, size, MREMAP_MAYMOVE) :
+		::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mDescriptor, 0)
+	};
+	if (map == MAP_FAILED)
+		return std::make_error_code(static_cast<std::errc>(errno));
+
+	auto const beg{mOutputDataBeg - mMap};
+	auto const end{mOutputDataEnd - mMap};
+	mMap = static_cast<std::byte*>(map);
+	mMapSize = size;
+	mOutputDataBeg = mMap + beg;
+	mOutputDataEnd = mMap + end;
+	mOutputEnd = mMap + mMapSize;
+	return {};
+}
+
+void
+MappedFileOutput::close()
+{
+	if (mDescriptor == -1)
+		return;
+	flush();
+
+	auto const size{getFileSize()};
+	::munmap(mMap, mMapSize);
+	mMap = mOutputDataEnd = nullptr;
+	mOutputDataBeg = mOutputEnd = nullptr;
+	mMapSize = 0;
+
+	auto const descriptor{std::exchange(mDescriptor, -1)};
+	auto const truncated{::ftruncate(descriptor, static_cast<::off_t>(size))};
+	auto const error{errno};
+	if (::close(descriptor) == -1 || truncated == -1)
+		throw Output::Exception{std::make_error_code(static_cast<std::errc>(truncated == -1 ? error : errno))};
+}
+
+std::size_t
+MappedFileOutput::getFileSize() const noexcept
+{ return mOutputDataEnd - mMap; }
+
+}//namespace Stream
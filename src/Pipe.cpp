@@ -1,6 +1,8 @@
 #include "Stream/Pipe.hpp"
+#include <climits>
 #include <cstring>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 
 
@@ -56,29 +58,98 @@ Pipe::~Pipe()
 
 std::size_t
 Pipe::readBytes(std::byte* dest, std::size_t size)
+{
+	auto r{tryReadBytes(dest, size)};
+	if (!r) [[unlikely]]
+		throw Input::Exception{r.error()};
+	return *r;
+}
+
+std::size_t
+Pipe::writeBytes(std::byte const* src, std::size_t size)
+{
+	auto r{tryWriteBytes(src, size)};
+	if (!r) [[unlikely]]
+		throw Output::Exception{r.error()};
+	return *r;
+}
+
+std::size_t
+Pipe::readVector(std::span<::iovec const> iov)
 {
 	while (true) {
-		auto r{::read(mReadDescriptor, dest, size)};
+		getInputProbe().syscall();
+		auto r{::readv(mReadDescriptor, iov.data(), static_cast<int>(std::min<std::size_t>(iov.size(), IOV_MAX)))};
 		if (r > 0)
 			return r;
 		if (r == 0)
 			throw Input::Exception{std::make_error_code(std::errc::no_message_available)};
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mReadDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
 		if (errno != EINTR)
 			throw Input::Exception{std::make_error_code(static_cast<std::errc>(errno))};
 	}
 }
 
 std::size_t
-Pipe::writeBytes(std::byte const* src, std::size_t size)
+Pipe::writeVector(std::span<::iovec const> iov)
 {
 	while (true) {
-		if (auto r{::write(mWriteDescriptor, src, size)}; r >= 0)
+		getOutputProbe().syscall();
+		if (auto r{::writev(mWriteDescriptor, iov.data(), static_cast<int>(std::min<std::size_t>(iov.size(), IOV_MAX)))}; r >= 0)
 			return r;
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mWriteDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
 		if (errno != EINTR)
 			throw Output::Exception{std::make_error_code(static_cast<std::errc>(errno))};
 	}
 }
 
+std::expected<std::size_t, std::error_code>
+Pipe::tryReadBytes(std::byte* dest, std::size_t size)
+{
+	while (true) {
+		getInputProbe().syscall();
+		auto r{::read(mReadDescriptor, dest, size)};
+		if (r > 0)
+			return r;
+		if (r == 0)
+			return std::unexpected{std::make_error_code(std::errc::no_message_available)};
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mReadDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
+		if (errno != EINTR)
+			return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
+	}
+}
+
+std::expected<std::size_t, std::error_code>
+Pipe::tryWriteBytes(std::byte const* src, std::size_t size)
+{
+	while (true) {
+		getOutputProbe().syscall();
+		if (auto r{::write(mWriteDescriptor, src, size)}; r >= 0)
+			return r;
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mWriteDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
+		if (errno != EINTR)
+			return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
+	}
+}
+
+std::error_code
+Pipe::waitReadable(unsigned) noexcept
+{
+	getInputProbe().syscall();
+	return Poll(mReadDescriptor, POLLIN);
+}
+
+std::error_code
+Pipe::waitWritable(unsigned) noexcept
+{
+	getOutputProbe().syscall();
+	return Poll(mWriteDescriptor, POLLOUT);
+}
+
 /**
  * @see		<a href="https://man7.org/linux/man-pages/man2/fcntl.2.html">fcntl()</a>
  * @see		<a href="https://man7.org/linux/man-pages/man2/fcntl.2.html#:~:text=F_SETPIPE_SZ">F_SETPIPE_SZ</a>
@@ -0,0 +1,130 @@
+#include "Stream/ReadAhead.hpp"
+#include <cstring>
+
+
+namespace Stream {
+
+ReadAheadInput::ReadAheadInput(std::size_t blockSize, std::size_t depth)
+		: mBlockSize{blockSize}
+		, mBlocks(depth)
+{
+	for (auto& block : mBlocks)
+		block.mData = std::make_unique_for_overwrite<std::byte[]>(blockSize);
+}
+
+ReadAheadInput::~ReadAheadInput()
+{
+	{
+		std::lock_guard lock{mMutex};
+		mStopped = true;
+	}
+	mCondition.notify_all();
+	mInterrupt.trigger();
+	if (mThread.joinable()) // a read blocking in the kernel is completed first
+		mThread.join();
+}
+
+std::expected<std::size_t, std::error_code>
+ReadAheadInput::tryProvideBytes(std::size_t const size)
+{
+	if (!mThread.joinable()) // the source is linked by now
+		mThread = std::jthread{[this] { run(); }};
+
+	if (auto const dataSize{getDataSize()}; !dataSize) {
+		// present the rest of the held block, or swap it for the next one, without copying
+		if ((!mSpilling || mHeldOffset == getHeld().mSize) && !swapBlock())
+			return std::unexpected{mError};
+		auto& held{getHeld()};
+		mSpilling = false;
+		mInputDataBeg = held.mData.get() + mHeldOffset;
+		mInputDataEnd = held.mData.get() + held.mSize;
+		mInputEnd = mInputDataEnd;
+		mHeldOffset = held.mSize;
+	} else { // the requested data crosses the end of the held block, put it together aside
+		if (!mSpilling) {
+			mSpill.assign(mInputDataBeg, static_cast<std::byte const*>(mInputDataEnd));
+			mSpilling = true;
+			mInputDataBeg = mSpill.data();
+			mInputDataEnd = mSpill.data() + mSpill.size();
+			mInputEnd = mInputDataEnd;
+		}
+		if (mHeldOffset == getHeld().mSize && !swapBlock())
+			return std::unexpected{mError};
+		spill(size - dataSize);
+	}
+	return std::min(size, getDataSize());
+}
+
+void
+ReadAheadInput::run() noexcept
+{
+	Interrupt::Install(&mInterrupt);
+	for (;;) {
+		Block* block;
+		{
+			std::unique_lock lock{mMutex};
+			mCondition.wait(lock, [this] { return mStopped || mFilled - mReleased < mBlocks.size(); });
+			if (mStopped)
+				return;
+			block = &mBlocks[mFilled % mBlocks.size()];
+		}
+
+		// a single read, so that a slow source hands over what it has instead of keeping the consumer waiting
+		auto r{getSource().tryReadSome(block->mData.get(), mBlockSize)};
+		block->mSize = r.value_or(0);
+		block->mError = r ? std::error_code{} : r.error();
+
+		{
+			std::lock_guard lock{mMutex};
+			++mFilled;
+		}
+		mCondition.notify_all();
+		if (!r)
+			return;
+	}
+}
+
+bool
+ReadAheadInput::swapBlock() noexcept
+{
+	std::unique_lock lock{mMutex};
+	if (mTaken > mReleased) {
+		++mReleased;
+		mCondition.notify_all();
+	}
+	if (mError)
+		return false;
+
+	mCondition.wait(lock, [this] { return mFilled > mTaken; });
+	auto const& block{mBlocks[mTaken++ % mBlocks.size()]};
+	mHeldOffset = 0;
+	mError = block.mError;
+	return block.mSize;
+}
+
+ReadAheadInput::Block&
+ReadAheadInput::getHeld() noexcept
+{ return mBlocks[(mTaken - 1) % mBlocks.size()]; }
+
+void
+ReadAheadInput::spill(std::size_t size)
+{
+	auto& held{getHeld()};
+	size = std::min(size, held.mSize - mHeldOffset);
+	auto const dataSize{getDataSize()};
+
+	std::memmove(mSpill.data(), mInputDataBeg, dataSize);
+	mSpill.resize(dataSize + size);
+	std::memcpy(mSpill.data() + dataSize, held.mData.get() + mHeldOffset, size);
+	mHeldOffset += size;
+
+	mInputDataBeg = mSpill.data();
+	mInputDataEnd = mSpill.data() + mSpill.size();
+	mInputEnd = mInputDataEnd;
+}
+
+std::size_t
+ReadAheadInput::getDepth() const noexcept
+{ return mBlocks.size(); }
+
+}//namespace Stream
@@ -0,0 +1,120 @@
+#include "Stream/RingBuffer.hpp"
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+namespace Stream {
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/memfd_create.2.html">memfd_create()</a>
+ */
+RingBufferInput::RingBufferInput(std::size_t initialBufferSize)
+		: mRing{Map(RoundToPage(initialBufferSize))}
+		, mRingSize{RoundToPage(initialBufferSize)}
+{
+	if (!mRing)
+		throw Exception{std::make_error_code(static_cast<std::errc>(errno))};
+	mInputBufferSize = mRingSize;
+	mInputDataBeg = mInputDataEnd = mRing;
+	mInputEnd = mRing + mRingSize;
+}
+
+RingBufferInput::RingBufferInput(RingBufferInput&& other) noexcept
+{ swap(*this, other); }
+
+void
+swap(RingBufferInput& a, RingBufferInput& b) noexcept
+{
+	swap(static_cast<BufferInput&>(a), static_cast<BufferInput&>(b));
+	std::swap(a.mRing, b.mRing);
+	std::swap(a.mRingSize, b.mRingSize);
+}
+
+RingBufferInput&
+RingBufferInput::operator=(RingBufferInput&& other) noexcept
+{
+	swap(*this, other);
+	return *this;
+}
+
+RingBufferInput::~RingBufferInput()
+{
+	if (mRing)
+		::munmap(mRing, 2 * mRingSize);
+}
+
+std::expected<std::size_t, std::error_code>
+RingBufferInput::tryProvideBytes(std::size_t const size)
+{
+	if (!prepareRing(size)) [[unlikely]]
+		return std::unexpected{make_error_code(Buffer::Exception::Code::BadAllocation)};
+
+	auto r{getSource().tryReadSome(mInputDataEnd, mInputEnd - mInputDataEnd)};
+	if (!r)
+		return r;
+	mInputDataEnd += *r;
+	return std::min(size, static_cast<std::size_t>(mInputDataEnd - mInputDataBeg));
+}
+
+bool
+RingBufferInput::prepareRing(std::size_t const size) noexcept
+{
+	if (mInputDataBeg >= mRing + mRingSize) { // consumed past the first mapping, same bytes are in the first one
+		mInputDataBeg -= mRingSize;
+		mInputDataEnd -= mRingSize;
+	}
+
+	if (size > mRingSize) { // the ring can not hold the requested size of data at once
+		auto const grown{mInputPolicy.grow(mRingSize, size)};
+		auto const newRingSize{grown ? RoundToPage(grown) : 0};
+		auto* ring{newRingSize ? Map(newRingSize) : nullptr};
+		if (!ring) [[unlikely]]
+			return false;
+
+		std::memcpy(ring, mInputDataBeg, mInputDataEnd - mInputDataBeg);
+		::munmap(mRing, 2 * mRingSize);
+		mInputDataEnd = ring + (mInputDataEnd - mInputDataBeg);
+		mInputDataBeg = ring;
+		mRing = ring;
+		mRingSize = mInputBufferSize = newRingSize;
+	}
+
+	mInputEnd = mInputDataBeg + mRingSize;
+	return true;
+}
+
+std::byte*
+RingBufferInput::Map(std::size_t const size) noexcept
+{
+	int const fd{::memfd_create("Stream::RingBufferInput", MFD_CLOEXEC)};
+	if (fd == -1)
+		return nullptr;
+
+	void* ring{MAP_FAILED};
+	if (::ftruncate(fd, static_cast<::off_t>(size)) != -1)
+		ring = ::mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ring != MAP_FAILED && (
+		::mmap(ring, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+		::mmap(static_cast<std::byte*>(ring) + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+	) {
+		auto const error{errno};
+		::munmap(ring, 2 * size);
+		ring = MAP_FAILED;
+		errno = error;
+	}
+
+	auto const error{errno};
+	::close(fd); // the mappings keep the memory alive
+	errno = error;
+	return ring == MAP_FAILED ? nullptr : static_cast<std::byte*>(ring);
+}
+
+std::size_t
+RingBufferInput::RoundToPage(std::size_t const size) noexcept
+{
+	static std::size_t const pageSize{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+	return ::ceilz(size, pageSize) * pageSize;
+}
+
+}//namespace Stream
@@ -0,0 +1,130 @@
+#include "Stream/Scan.hpp"
+#include <algorithm>
+#include <bit>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+namespace Stream {
+
+static char const*
+FindByteScalar(char const* beg, char const* const end, char const c) noexcept
+{
+	while (beg != end && *beg != c)
+		++beg;
+	return beg;
+}
+
+static char const*
+SkipDigitsScalar(char const* beg, char const* const end, unsigned const base) noexcept
+{
+	auto const digits{std::min(base, 10u)};
+	auto const letters{base - digits};
+	while (beg != end && (
+		static_cast<unsigned char>(*beg - '0') < digits ||
+		static_cast<unsigned char>((*beg | 0x20) - 'a') < letters
+	))
+		++beg;
+	return beg;
+}
+
+#if defined(__x86_64__)
+
+static char const*
+FindByteSse2(char const* beg, char const* const end, char const c) noexcept
+{
+	auto const needle{_mm_set1_epi8(c)};
+	for (; end - beg >= 16; beg += 16) {
+		auto const chunk{_mm_loadu_si128(reinterpret_cast<__m128i const*>(beg))};
+		if (auto const mask{static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))})
+			return beg + std::countr_zero(mask);
+	}
+	return FindByteScalar(beg, end, c);
+}
+
+[[gnu::target("avx2")]]
+static char const*
+FindByteAvx2(char const* beg, char const* const end, char const c) noexcept
+{
+	auto const needle{_mm256_set1_epi8(c)};
+	for (; end - beg >= 32; beg += 32) {
+		auto const chunk{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(beg))};
+		if (auto const mask{static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)))})
+			return beg + std::countr_zero(mask);
+	}
+	return FindByteSse2(beg, end, c);
+}
+
+/**
+ * A character is a digit if its distance from '0' is below the number of digits, or the distance of its lower case
+ * from 'a' is below the number of letters. The distances are unsigned, so the characters before the ranges are far,
+ * and a distance is below a count if subtracting it from the count with saturation leaves something.
+ */
+static char const*
+SkipDigitsSse2(char const* beg, char const* const end, unsigned const base) noexcept
+{
+	auto const digits{_mm_set1_epi8(static_cast<char>(std::min(base, 10u)))};
+	auto const letters{_mm_set1_epi8(static_cast<char>(base - std::min(base, 10u)))};
+	auto const zero{_mm_set1_epi8('0')};
+	auto const a{_mm_set1_epi8('a')};
+	auto const lowerCase{_mm_set1_epi8(0x20)};
+	auto const none{_mm_setzero_si128()};
+	for (; end - beg >= 16; beg += 16) {
+		auto const chunk{_mm_loadu_si128(reinterpret_cast<__m128i const*>(beg))};
+		auto const digit{_mm_subs_epu8(digits, _mm_sub_epi8(chunk, zero))};
+		auto const letter{_mm_subs_epu8(letters, _mm_sub_epi8(_mm_or_si128(chunk, lowerCase), a))};
+		if (auto const mask{static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(digit, letter), none)))})
+			return beg + std::countr_zero(mask);
+	}
+	return SkipDigitsScalar(beg, end, base);
+}
+
+[[gnu::target("avx2")]]
+static char const*
+SkipDigitsAvx2(char const* beg, char const* const end, unsigned const base) noexcept
+{
+	auto const digits{_mm256_set1_epi8(static_cast<char>(std::min(base, 10u)))};
+	auto const letters{_mm256_set1_epi8(static_cast<char>(base - std::min(base, 10u)))};
+	auto const zero{_mm256_set1_epi8('0')};
+	auto const a{_mm256_set1_epi8('a')};
+	auto const lowerCase{_mm256_set1_epi8(0x20)};
+	auto const none{_mm256_setzero_si256()};
+	for (; end - beg >= 32; beg += 32) {
+		auto const chunk{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(beg))};
+		auto const digit{_mm256_subs_epu8(digits, _mm256_sub_epi8(chunk, zero))};
+		auto const letter{_mm256_subs_epu8(letters, _mm256_sub_epi8(_mm256_or_si256(chunk, lowerCase), a))};
+		if (auto const mask{static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_or_si256(digit, letter), none)))})
+			return beg + std::countr_zero(mask);
+	}
+	return SkipDigitsSse2(beg, end, base);
+}
+
+static bool const HasAvx2{[] {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+}()};
+
+#endif
+
+char const*
+FindByte(char const* beg, char const* end, char c) noexcept
+{
+#if defined(__x86_64__)
+	return HasAvx2 ? FindByteAvx2(beg, end, c) : FindByteSse2(beg, end, c);
+#else
+	return FindByteScalar(beg, end, c);
+#endif
+}
+
+char const*
+SkipDigits(char const* beg, char const* end, unsigned base) noexcept
+{
+#if defined(__x86_64__)
+	return HasAvx2 ? SkipDigitsAvx2(beg, end, base) : SkipDigitsSse2(beg, end, base);
+#else
+	return SkipDigitsScalar(beg, end, base);
+#endif
+}
+
+}//namespace Stream
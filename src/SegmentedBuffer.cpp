@@ -0,0 +1,165 @@
+#include "Stream/SegmentedBuffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+namespace Stream {
+
+SegmentedBufferOutput::SegmentedBufferOutput(std::size_t segmentSize, std::pmr::memory_resource* resource)
+		: mSegmentSize{segmentSize}
+		, mResource{resource}
+{
+	mSegments.push_back({
+		{static_cast<std::byte*>(resource->allocate(segmentSize)), {resource, segmentSize}},
+		segmentSize
+	});
+}
+
+SegmentedBufferOutput::SegmentedBufferOutput(SegmentedBufferOutput&& other) noexcept
+		: mSegmentSize{0}
+		, mResource{std::pmr::get_default_resource()}
+{ swap(*this, other); }
+
+void
+swap(SegmentedBufferOutput& a, SegmentedBufferOutput& b) noexcept
+{
+	swap(static_cast<Output&>(a), static_cast<Output&>(b));
+	std::swap(a.mSegments, b.mSegments);
+	std::swap(a.mCurrent, b.mCurrent);
+	std::swap(a.mSegmentSize, b.mSegmentSize);
+	std::swap(a.mResource, b.mResource);
+}
+
+SegmentedBufferOutput&
+SegmentedBufferOutput::operator=(SegmentedBufferOutput&& other) noexcept
+{
+	swap(*this, other);
+	return *this;
+}
+
+SegmentedBufferOutput::~SegmentedBufferOutput()
+{
+	if (mSegments.empty()) // moved from
+		return;
+	try {
+		flush();
+	} catch (Output::Exception const& exc) {
+		// Nothing can be done
+		LOG_ERR(exc.what())
+	}
+}
+
+std::size_t
+SegmentedBufferOutput::writeBytes(std::byte const* src, std::size_t size)
+{
+	std::size_t total{0};
+	while (total < size) {
+		auto const n{allocSome(size - total)};
+		std::memcpy(begin(), src + total, n);
+		produced(n);
+		total += n;
+	}
+	return total;
+}
+
+void
+SegmentedBufferOutput::flush()
+{
+	std::vector<::iovec> iov;
+	iov.reserve(mCurrent + 1);
+	for (std::size_t i{0}; i <= mCurrent; ++i)
+		if (auto& segment{mSegments[i]}; segment.mEnd > segment.mBeg)
+			iov.push_back({segment.mData.get() + segment.mBeg, segment.mEnd - segment.mBeg});
+
+	if (!iov.empty()) {
+		try {
+			getSink().write(iov);
+		} catch (Output::Exception const& exc) {
+			consume(getDataSize() - exc.getUnwrittenSize());
+			throw;
+		}
+	}
+
+	// everything is written, keep the segments of the usual size for reuse, there is always at least one
+	std::erase_if(mSegments, [this](auto const& segment) { return segment.mSize != mSegmentSize; });
+	for (auto& segment : mSegments)
+		segment.mBeg = segment.mEnd = 0;
+	mCurrent = 0;
+}
+
+void
+SegmentedBufferOutput::advance(std::size_t const size)
+{
+	if (mSegments[mCurrent].mEnd) // the current segment has data, move on to the next one
+		++mCurrent;
+	if (mCurrent < mSegments.size() && mSegments[mCurrent].mSize >= size) // reuse a spare segment
+		return;
+
+	auto const segmentSize{std::max(size, mSegmentSize)};
+	try {
+		mSegments.insert(mSegments.begin() + static_cast<std::ptrdiff_t>(mCurrent), {
+			{static_cast<std::byte*>(mResource->allocate(segmentSize)), {mResource, segmentSize}},
+			segmentSize
+		});
+	} catch (std::bad_alloc const&) {
+		throw Output::Exception{make_error_code(Buffer::Exception::Code::BadAllocation)};
+	}
+}
+
+void
+SegmentedBufferOutput::consume(std::size_t size) noexcept
+{
+	for (std::size_t i{0}; i <= mCurrent && size; ++i) {
+		auto& segment{mSegments[i]};
+		auto const n{std::min(size, segment.mEnd - segment.mBeg)};
+		segment.mBeg += n;
+		size -= n;
+	}
+}
+
+std::size_t
+SegmentedBufferOutput::allocSome(std::size_t const size)
+{
+	if (!getSpaceSize())
+		advance(1);
+	return std::min(size, getSpaceSize());
+}
+
+std::size_t
+SegmentedBufferOutput::alloc(std::size_t const size)
+{
+	if (size > getSpaceSize())
+		advance(size);
+	return size;
+}
+
+void
+SegmentedBufferOutput::produced(std::size_t size) noexcept
+{ mSegments[mCurrent].mEnd += size; }
+
+std::size_t
+SegmentedBufferOutput::getSpaceSize() const noexcept
+{ return mSegments[mCurrent].mSize - mSegments[mCurrent].mEnd; }
+
+std::size_t
+SegmentedBufferOutput::getDataSize() const noexcept
+{
+	std::size_t total{0};
+	for (std::size_t i{0}; i <= mCurrent; ++i)
+		total += mSegments[i].mEnd - mSegments[i].mBeg;
+	return total;
+}
+
+std::size_t
+SegmentedBufferOutput::getSegmentCount() const noexcept
+{ return mSegments.size(); }
+
+std::byte*
+SegmentedBufferOutput::begin() noexcept
+{ return mSegments[mCurrent].mData.get() + mSegments[mCurrent].mEnd; }
+
+std::byte const*
+SegmentedBufferOutput::end() const noexcept
+{ return mSegments[mCurrent].mData.get() + mSegments[mCurrent].mSize; }
+
+}//namespace Stream
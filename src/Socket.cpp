@@ -1,7 +1,9 @@
 #include "Stream/Socket.hpp"
+#include <climits>
 #include <cstring>
 #include <netdb.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <unistd.h>
 
 
@@ -90,28 +92,103 @@ Socket::~Socket()
 std::size_t
 Socket::readBytes(std::byte* dest, std::size_t size)
 {
+	auto r{tryReadBytes(dest, size)};
+	if (!r) [[unlikely]]
+		throw Input::Exception{r.error()};
+	return *r;
+}
+
+std::size_t
+Socket::writeBytes(std::byte const* src, std::size_t size)
+{
+	auto r{tryWriteBytes(src, size)};
+	if (!r) [[unlikely]]
+		throw Output::Exception{r.error()};
+	return *r;
+}
+
+std::size_t
+Socket::readVector(std::span<::iovec const> iov)
+{
+	::msghdr msg{};
+	msg.msg_iov = const_cast<::iovec*>(iov.data());
+	msg.msg_iovlen = std::min<std::size_t>(iov.size(), IOV_MAX);
 	while (true) {
-		auto r{::recv(mDescriptor, dest, size, 0)};
+		getInputProbe().syscall();
+		auto r{::recvmsg(mDescriptor, &msg, 0)};
 		if (r > 0)
 			return r;
 		if (r == 0)
 			throw Input::Exception{std::make_error_code(std::errc::no_message_available)};
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
 		if (errno != EINTR)
 			throw Input::Exception{std::make_error_code(static_cast<std::errc>(errno))};
 	}
 }
 
 std::size_t
-Socket::writeBytes(std::byte const* src, std::size_t size)
+Socket::writeVector(std::span<::iovec const> iov)
 {
+	::msghdr msg{};
+	msg.msg_iov = const_cast<::iovec*>(iov.data());
+	msg.msg_iovlen = std::min<std::size_t>(iov.size(), IOV_MAX);
 	while (true) {
-		if (auto r{::send(mDescriptor, src, size, MSG_NOSIGNAL)}; r >= 0)
+		getOutputProbe().syscall();
+		if (auto r{::sendmsg(mDescriptor, &msg, MSG_NOSIGNAL)}; r >= 0)
 			return r;
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
 		if (errno != EINTR)
 			throw Output::Exception{std::make_error_code(static_cast<std::errc>(errno))};
 	}
 }
 
+std::expected<std::size_t, std::error_code>
+Socket::tryReadBytes(std::byte* dest, std::size_t size)
+{
+	while (true) {
+		getInputProbe().syscall();
+		auto r{::recv(mDescriptor, dest, size, 0)};
+		if (r > 0)
+			return r;
+		if (r == 0)
+			return std::unexpected{std::make_error_code(std::errc::no_message_available)};
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
+		if (errno != EINTR)
+			return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
+	}
+}
+
+std::expected<std::size_t, std::error_code>
+Socket::tryWriteBytes(std::byte const* src, std::size_t size)
+{
+	while (true) {
+		getOutputProbe().syscall();
+		if (auto r{::send(mDescriptor, src, size, MSG_NOSIGNAL)}; r >= 0)
+			return r;
+		if ((errno == EAGAIN || errno == EWOULDBLOCK) && IsNonBlocking(mDescriptor)) // wait before retrying, a blocking one timed out
+			return 0;
+		if (errno != EINTR)
+			return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
+	}
+}
+
+std::error_code
+Socket::waitReadable(unsigned) noexcept
+{
+	getInputProbe().syscall();
+	return Poll(mDescriptor, POLLIN);
+}
+
+std::error_code
+Socket::waitWritable(unsigned) noexcept
+{
+	getOutputProbe().syscall();
+	return Poll(mDescriptor, POLLOUT);
+}
+
 /**
  * @see	<a href="https://man7.org/linux/man-pages/man2/bind.2.html">bind()</a>
  */
@@ -170,6 +247,19 @@ Socket::getMSS() const noexcept
 	return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
 }
 
+/**
+ * @see	<a href="https://man7.org/linux/man-pages/man2/getsockname.2.html">getsockname()</a>
+ */
+std::expected<std::uint16_t, std::error_code>
+Socket::getPort() const noexcept
+{
+	sockaddr_in address;
+	socklen_t addrlen{sizeof address};
+	if (::getsockname(mDescriptor, reinterpret_cast<sockaddr*>(&address), &addrlen) != -1)
+		return ::ntohs(address.sin_port);
+	return std::unexpected{std::make_error_code(static_cast<std::errc>(errno))};
+}
+
 std::expected<::timeval, std::error_code>
 Socket::getRecvTimeout() const noexcept
 {
@@ -0,0 +1,50 @@
+#include "Stream/Stats.hpp"
+#include <algorithm>
+#include <numeric>
+
+
+namespace Stream {
+
+std::uint64_t
+Histogram::getCount() const noexcept
+{ return std::accumulate(buckets.begin(), buckets.end(), std::uint64_t{0}); }
+
+std::chrono::nanoseconds
+Histogram::getPercentile(double p) const noexcept
+{
+	auto const count{getCount()};
+	if (!count)
+		return std::chrono::nanoseconds{0};
+
+	auto const rank{std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(count) + 0.5))};
+	std::uint64_t seen{0};
+	for (std::size_t i{0}; i < Size; ++i)
+		if ((seen += buckets[i]) >= rank)
+			return std::chrono::nanoseconds{std::int64_t{1} << i};
+	return std::chrono::nanoseconds{std::int64_t{1} << (Size - 1)};
+}
+
+void
+Stats::reset() noexcept
+{ *this = {}; }
+
+Stats const&
+Probe::getStats() const noexcept
+{
+#if defined(STREAM_INSTRUMENTATION)
+	return mStats;
+#else
+	static Stats const empty;
+	return empty;
+#endif
+}
+
+void
+Probe::reset() noexcept
+{
+#if defined(STREAM_INSTRUMENTATION)
+	mStats.reset();
+#endif
+}
+
+}//namespace Stream
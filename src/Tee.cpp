@@ -0,0 +1,181 @@
+#include "Stream/Tee.hpp"
+#include <algorithm>
+
+
+namespace Stream {
+
+TeeOutput::TeeOutput(Policy policy, std::size_t limit) noexcept
+		: Output{false}
+		, mPolicy{policy}
+		, mLimit{limit}
+{}
+
+TeeOutput::TeeOutput(TeeOutput&& other) noexcept
+		: Output{false}
+{ swap(*this, other); }
+
+void
+swap(TeeOutput& a, TeeOutput& b) noexcept
+{
+	swap(static_cast<Output&>(a), static_cast<Output&>(b));
+	std::swap(a.mBranches, b.mBranches);
+	std::swap(a.mPolicy, b.mPolicy);
+	std::swap(a.mLimit, b.mLimit);
+	std::swap(a.mFailedBase, b.mFailedBase);
+	std::swap(a.mFailedSize, b.mFailedSize);
+}
+
+TeeOutput&
+TeeOutput::operator=(TeeOutput&& other) noexcept
+{
+	swap(*this, other);
+	return *this;
+}
+
+TeeOutput::~TeeOutput()
+{
+	for (auto& branch : mBranches)
+		try {
+			Settle(branch, 0);
+		} catch (Output::Exception const& exc) {
+			// Nothing can be done
+			LOG_ERR(exc.what())
+		}
+}
+
+std::size_t
+TeeOutput::writeBytes(std::byte const* src, std::size_t size)
+{
+	::iovec const iov[]{{const_cast<std::byte*>(src), size}};
+	return writeVector(iov);
+}
+
+std::size_t
+TeeOutput::writeVector(std::span<::iovec const> iov)
+{
+	std::size_t total{0};
+	for (auto const& v : iov)
+		total += v.iov_len;
+
+	if (mPolicy == Policy::Block) {
+		void const* const base{iov.empty() ? nullptr : iov.front().iov_base};
+		if (base != mFailedBase || total != mFailedSize) // not a retry of the interrupted write
+			for (auto& branch : mBranches)
+				branch.mDone = 0;
+		mFailedBase = base;
+		mFailedSize = total;
+
+		for (auto& branch : mBranches)
+			if (branch.mDone < total) // not written before a later sink threw
+				writeBlocking(branch, iov);
+		for (auto& branch : mBranches)
+			branch.mDone = 0;
+		mFailedBase = nullptr;
+		mFailedSize = 0;
+	} else {
+		for (auto& branch : mBranches)
+			writeBuffered(branch, iov);
+	}
+	return total;
+}
+
+void
+TeeOutput::flush()
+{
+	for (auto& branch : mBranches) {
+		Settle(branch, 0);
+		*branch.mSink < nullptr;
+	}
+}
+
+/**
+ * Write @p iov to the sink after the part it already got, keeping track of the part written when the sink throws
+ */
+void
+TeeOutput::writeBlocking(Branch& branch, std::span<::iovec const> iov)
+{
+	auto& sink{*branch.mSink};
+	auto skip{branch.mDone};
+	while (skip >= iov.front().iov_len) {
+		skip -= iov.front().iov_len;
+		iov = iov.subspan(1);
+	}
+
+	std::size_t requested{0};
+	try {
+		if (skip) { // continue the partially written area on its own
+			requested = iov.front().iov_len - skip;
+			sink.write(static_cast<std::byte const*>(iov.front().iov_base) + skip, requested);
+			branch.mDone += requested;
+			iov = iov.subspan(1);
+		}
+		requested = 0;
+		for (auto const& v : iov)
+			requested += v.iov_len;
+		sink.write(iov);
+		branch.mDone += requested;
+	} catch (Output::Exception const& exc) {
+		branch.mDone += requested - exc.getUnwrittenSize();
+		throw;
+	}
+}
+
+/**
+ * Write as much of the backlog and @p iov as the sink accepts without waiting, keep the rest in the backlog
+ */
+void
+TeeOutput::writeBuffered(Branch& branch, std::span<::iovec const> iov)
+{
+	auto& sink{*branch.mSink};
+	std::size_t written{0};
+
+	if (branch.mBacklogPos < branch.mBacklog.size())
+		branch.mBacklogPos += WriteBytes(sink, branch.mBacklog.data() + branch.mBacklogPos, branch.mBacklog.size() - branch.mBacklogPos);
+	if (branch.mBacklogPos == branch.mBacklog.size()) {
+		branch.mBacklog.clear();
+		branch.mBacklogPos = 0;
+		// skip the empty areas, writeVector needs a non-empty one
+		auto const first{std::ranges::find_if(iov, [](auto const& v) { return v.iov_len != 0; })};
+		if (first != iov.end())
+			written = WriteVector(sink, iov.subspan(first - iov.begin()));
+	}
+
+	// the order must be kept, so everything after the written part goes to the backlog
+	for (auto const& v : iov) {
+		auto const skip{std::min(written, v.iov_len)};
+		written -= skip;
+		auto const* data{static_cast<std::byte const*>(v.iov_base)};
+		branch.mBacklog.insert(branch.mBacklog.end(), data + skip, data + v.iov_len);
+	}
+
+	Settle(branch, mLimit);
+}
+
+/**
+ * Wait for the sink of @p branch until its backlog is not larger than @p limit
+ */
+void
+TeeOutput::Settle(Branch& branch, std::size_t limit)
+{
+	auto& sink{*branch.mSink};
+	while (branch.mBacklog.size() - branch.mBacklogPos > limit)
+		branch.mBacklogPos += WriteAvailable(sink, branch.mBacklog.data() + branch.mBacklogPos, branch.mBacklog.size() - branch.mBacklogPos);
+
+	if (branch.mBacklogPos == branch.mBacklog.size()) {
+		branch.mBacklog.clear();
+		branch.mBacklogPos = 0;
+	} else if (branch.mBacklogPos > branch.mBacklog.size() / 2) {
+		branch.mBacklog.erase(branch.mBacklog.begin(), branch.mBacklog.begin() + static_cast<std::ptrdiff_t>(branch.mBacklogPos));
+		branch.mBacklogPos = 0;
+	}
+}
+
+std::size_t
+TeeOutput::getSinkCount() const noexcept
+{ return mBranches.size(); }
+
+std::size_t
+TeeOutput::getBacklogSize(std::size_t index) const noexcept
+{ return mBranches[index].mBacklog.size() - mBranches[index].mBacklogPos; }
+
+}//namespace Stream
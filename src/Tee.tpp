@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Stream/Tee.hpp"
+
+
+namespace Stream {
+
+template <typename S, typename T>
+T&
+operator<(S& sink, T& tee)
+requires (std::derived_from<S, Output> &&
+	std::derived_from<T, Output> && std::derived_from<T, TeeOutput>)
+{
+	static_cast<TeeOutput&>(tee).mBranches.push_back({&sink, {}, 0, 0});
+	return tee;
+}
+
+template <typename T>
+T&
+operator<(std::nullptr_t, T& tee) noexcept
+requires (std::derived_from<T, Output> && std::derived_from<T, TeeOutput>)
+{
+	static_cast<TeeOutput&>(tee).mBranches.clear();
+	return tee;
+}
+
+}//namespace Stream
@@ -1,4 +1,5 @@
 #include "Stream/Text.hpp"
+#include "Stream/Scan.hpp"
 
 namespace Stream {
 
@@ -11,56 +12,51 @@ TextInput::checkFromChars(std::from_chars_result r)
 	return *this;
 }
 
+bool
+TextInput::provideAt(std::size_t const i)
+{
+	while (i >= getSource().getDataSize())
+		if (auto r{getSource().tryProvideSomeMore(1)}; !r) {
+			if (r.error() != std::make_error_code(std::errc::no_message_available))
+				throw Exception{r.error()};
+			return false;
+		}
+	return true;
+}
+
 std::size_t
 TextInput::provideFloat(std::size_t const start, std::chars_format const fmt, std::size_t const intLimit, std::size_t const fracLimit, std::size_t const expLimit)
 {
 	auto i{start};
-	try {
-		if (i == getSource().getDataSize())
-			getSource().provideSomeMore(1);
-		if (getSource()[i] == std::byte{'-'}) // optional
-			++i;
-		if (fmt != std::chars_format::hex) {
-			if (auto r{provideDigits10(i, intLimit)}) try {
-				i += provideDecFrac(i += r, fracLimit);
-				if (fmt != std::chars_format::fixed)
-					i += provideDecExp(i, expLimit);
-			} catch (Input::Exception const& exc) {
-				if (exc.code() != std::make_error_code(std::errc::no_message_available))
-					throw;
-			}
-		} else {
-			if (auto r{provideDigits36(i, intLimit)}) try {
-				i += provideHexFrac(i += r, fracLimit);
-				i += provideHexExp(i, expLimit);
-			} catch (Input::Exception const& exc) {
-				if (exc.code() != std::make_error_code(std::errc::no_message_available))
-					throw;
-			}
+	if (!provideAt(i))
+		throw Exception{std::make_error_code(std::errc::no_message_available)};
+	if (getSource()[i] == std::byte{'-'} && !provideAt(++i)) // optional
+		return 0;
+	if (fmt != std::chars_format::hex) {
+		if (auto r{provideDigits10(i, intLimit)}) {
+			i += provideDecFrac(i += r, fracLimit);
+			if (fmt != std::chars_format::fixed)
+				i += provideDecExp(i, expLimit);
+		}
+	} else {
+		if (auto r{provideDigits36(i, intLimit)}) {
+			i += provideHexFrac(i += r, fracLimit);
+			i += provideHexExp(i, expLimit);
 		}
-		return i - start;
-	} catch (Input::Exception const& exc) {
-		if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-			throw;
 	}
-	return 0;
+	return i - start;
 }
 
 std::size_t
 TextInput::provideSignedInt(std::size_t const start, std::size_t const limit, unsigned const base)
 {
 	auto i{start};
-	try {
-		if (i == getSource().getDataSize())
-			getSource().provideSomeMore(1);
-		if (getSource()[i] == std::byte{'-'}) // optional
-			++i;
-		if (auto r{provideUnsignedInt(i, limit, base)})
-			return i - start + r;
-	} catch (Input::Exception const& exc) {
-		if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-			throw;
-	}
+	if (!provideAt(i))
+		throw Exception{std::make_error_code(std::errc::no_message_available)};
+	if (getSource()[i] == std::byte{'-'} && !provideAt(++i)) // optional
+		return 0;
+	if (auto r{provideUnsignedInt(i, limit, base)})
+		return i - start + r;
 	return 0;
 }
 
@@ -72,16 +68,9 @@ std::size_t
 TextInput::provideDecFrac(std::size_t const start, std::size_t const fracLimit)
 {
 	auto i{start};
-	try {
-		if (i == getSource().getDataSize())
-			getSource().provideSomeMore(1);
-		if (getSource()[i] == std::byte{'.'}) // required
-			if (auto r{provideDigits10(++i, fracLimit)})
-				return i - start + r;
-	} catch (Input::Exception const& exc) {
-		if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-			throw;
-	}
+	if (provideAt(i) && getSource()[i] == std::byte{'.'} && provideAt(++i)) // required
+		if (auto r{provideDigits10(i, fracLimit)})
+			return i - start + r;
 	return 0;
 }
 
@@ -89,60 +78,24 @@ std::size_t
 TextInput::provideDecExp(std::size_t const start, std::size_t const expLimit)
 {
 	auto i{start};
-	try {
-		if (i == getSource().getDataSize())
-			getSource().provideSomeMore(1);
-		if (getSource()[i] == std::byte{'e'} || getSource()[i] == std::byte{'E'}) { // required
-			if (++i == getSource().getDataSize())
-				getSource().provideSomeMore(1);
-			if (getSource()[i] == std::byte{'-'} || getSource()[i] == std::byte{'+'}) // required
-				if (auto r{provideDigits10(++i, expLimit)})
-					return i - start + r;
-		}
-	} catch (Input::Exception const& exc) {
-		if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-			throw;
-	}
+	if (provideAt(i) && (getSource()[i] == std::byte{'e'} || getSource()[i] == std::byte{'E'}) && provideAt(++i)) // required
+		if ((getSource()[i] == std::byte{'-'} || getSource()[i] == std::byte{'+'}) && provideAt(++i)) // required
+			if (auto r{provideDigits10(i, expLimit)})
+				return i - start + r;
 	return 0;
 }
 
 std::size_t
 TextInput::provideDigits10(std::size_t const start, std::size_t const limit, unsigned const base)
-{
-	auto i{start};
-	char const d = '0' + base;
-	while (true) {
-		char const* s{reinterpret_cast<char const*>(getSource().begin())};
-		for (auto const e{getSource().getDataSize()}; i < e; ++i) {
-			if (!(s[i] >= '0' && s[i] < d))
-				return i - start;
-			if (i - start == limit)
-				throw Exception{std::make_error_code(std::errc::result_out_of_range)};
-		}
-		try {
-			getSource().provideSomeMore(1);
-		} catch (Input::Exception const& exc) {
-			if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-				throw;
-			return i - start;
-		}
-	}
-}
+{ return provideDigits(start, limit, base); }
 
 std::size_t
 TextInput::provideHexFrac(std::size_t const start, std::size_t const fracLimit)
 {
 	auto i{start};
-	try {
-		if (i == getSource().getDataSize())
-			getSource().provideSomeMore(1);
-		if (getSource()[i] == std::byte{'.'}) // required
-			if (auto r{provideDigits36(++i, fracLimit)})
-				return i - start + r;
-	} catch (Input::Exception const& exc) {
-		if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-			throw;
-	}
+	if (provideAt(i) && getSource()[i] == std::byte{'.'} && provideAt(++i)) // required
+		if (auto r{provideDigits36(i, fracLimit)})
+			return i - start + r;
 	return 0;
 }
 
@@ -150,42 +103,34 @@ std::size_t
 TextInput::provideHexExp(std::size_t const start, std::size_t const expLimit)
 {
 	auto i{start};
-	try {
-		if (i == getSource().getDataSize())
-			getSource().provideSomeMore(1);
-		if (getSource()[i] == std::byte{'p'} || getSource()[i] == std::byte{'P'}) { // required
-			if (++i == getSource().getDataSize())
-				getSource().provideSomeMore(1);
-			if (getSource()[i] == std::byte{'-'} || getSource()[i] == std::byte{'+'}) // required
-				if (auto r{provideDigits36(++i, expLimit)})
-					return i - start + r;
-		}
-	} catch (Input::Exception const& exc) {
-		if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-			throw;
-	}
+	if (provideAt(i) && (getSource()[i] == std::byte{'p'} || getSource()[i] == std::byte{'P'}) && provideAt(++i)) // required
+		if ((getSource()[i] == std::byte{'-'} || getSource()[i] == std::byte{'+'}) && provideAt(++i)) // required
+			if (auto r{provideDigits36(i, expLimit)})
+				return i - start + r;
 	return 0;
 }
 
 std::size_t
 TextInput::provideDigits36(std::size_t const start, std::size_t const limit, unsigned const base)
+{ return provideDigits(start, limit, base); }
+
+std::size_t
+TextInput::provideDigits(std::size_t const start, std::size_t const limit, unsigned const base)
 {
 	auto i{start};
-	char const d = 'a' + base - 10;
-	char const D = 'A' + base - 10;
 	while (true) {
 		char const* s{reinterpret_cast<char const*>(getSource().begin())};
-		for (auto const e{getSource().getDataSize()}; i < e; ++i) {
-			if (!(s[i] >= '0' && s[i] <= '9' || s[i] >= 'a' && s[i] < d || s[i] >= 'A' && s[i] < D))
-				return i - start;
-			if (i - start == limit)
+		if (auto const e{getSource().getDataSize()}; i < e) {
+			auto const end{e - start > limit ? start + limit + 1 : e}; // a digit after limit digits is out of range
+			if (auto const* p{SkipDigits(s + i, s + end, base)}; p != s + end)
+				return p - s - start;
+			if (e - start > limit)
 				throw Exception{std::make_error_code(std::errc::result_out_of_range)};
+			i = e;
 		}
-		try {
-			getSource().provideSomeMore(1);
-		} catch (Input::Exception const& exc) {
-			if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-				throw;
+		if (!provideAt(i)) {
+			if (i == start)
+				throw Exception{std::make_error_code(std::errc::no_message_available)};
 			return i - start;
 		}
 	}
@@ -197,17 +142,19 @@ TextInput::provideUntil(std::size_t const start, std::size_t const limit, char c
 	auto i{start};
 	while (true) {
 		char const* s{reinterpret_cast<char const*>(getSource().begin())};
-		for (auto const e {getSource().getDataSize()}; i < e; ++i) {
-			if (s[i] == delim)
-				return {i - start, i - start + 1};
-			if (i - start == limit)
+		if (auto const e{getSource().getDataSize()}; i < e) {
+			auto const end{e - start > limit ? start + limit + 1 : e}; // the delimiter may follow limit characters
+			if (auto const* p{FindByte(s + i, s + end, delim)}; p != s + end) {
+				auto const len{static_cast<std::size_t>(p - s) - start};
+				return {len, len + 1};
+			}
+			if (e - start > limit)
 				throw Exception{std::make_error_code(std::errc::result_out_of_range)};
+			i = e;
 		}
-		try {
-			getSource().provideSomeMore(1);
-		} catch (Input::Exception const& exc) {
-			if (exc.code() != std::make_error_code(std::errc::no_message_available) || i == start)
-				throw;
+		if (!provideAt(i)) {
+			if (i == start)
+				throw Exception{std::make_error_code(std::errc::no_message_available)};
 			return {i - start, i - start};
 		}
 	}
@@ -224,6 +171,31 @@ TextInput::getLine(std::size_t const limit)
 	return {str, len};
 }
 
+std::size_t
+TextInput::getLines(std::span<std::string_view> const lines, std::size_t const limit)
+{
+	if (lines.empty() || !provideAt(0))
+		return 0;
+	auto [len, size]{provideUntil(0, limit, '\n')}; // the first line may need a refill
+	char const* s{reinterpret_cast<char const*>(getSource().begin())};
+	if (len && len < size && s[len - 1] == '\r')
+		--len;
+	lines[0] = {s, len};
+
+	std::size_t n{1};
+	auto pos{size};
+	for (auto const e{getSource().getDataSize()}; n < lines.size() && pos < e; ++n) {
+		auto const* p{FindByte(s + pos, s + e, '\n')};
+		len = p - s - pos;
+		if (p == s + e || len > limit) // left for the next call
+			break;
+		lines[n] = {s + pos, len - (len && p[-1] == '\r')};
+		pos += len + 1;
+	}
+	getSource().consumed(pos);
+	return n;
+}
+
 std::string_view
 TextInput::getUntil(char const delim, std::size_t const limit)
 {
@@ -246,6 +218,29 @@ TextOutput&
 TextOutput::operator<<(bool const b)
 { return reinterpret_cast<TextOutput&>(write(b ? "true" : "false", 5 - b)); }
 
+TextOutput&
+TextOutput::operator<<(Histogram const& h)
+{
+	return *this
+		<< "count=" << h.getCount()
+		<< " p50<=" << h.getPercentile(0.5).count()
+		<< "ns p90<=" << h.getPercentile(0.9).count()
+		<< "ns p99<=" << h.getPercentile(0.99).count()
+		<< "ns max<=" << h.getPercentile(1).count() << "ns";
+}
+
+TextOutput&
+TextOutput::operator<<(Stats const& s)
+{
+	return *this
+		<< "calls=" << s.calls
+		<< " bytes=" << s.bytes
+		<< " syscalls=" << s.syscalls
+		<< " waits=" << s.waits
+		<< " latency{" << s.latency
+		<< "} flush{" << s.flushLatency << '}';
+}
+
 std::size_t
 Text::UppercaseHash::operator()(std::string const& h) const
 {	// Convert to uppercase before calculating the hash value
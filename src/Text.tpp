@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Stream/Text.hpp"
+#include <bit>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
 
 namespace Stream {
 
@@ -14,6 +18,78 @@ consteval std::size_t digits10(int i)
 	return r;
 }
 
+/**
+ * Check whether the 8 characters loaded into @p chunk are all decimal digits
+ */
+constexpr bool
+isEightDigits(std::uint64_t const chunk) noexcept
+{ return ((chunk & 0xf0f0f0f0f0f0f0f0) | (((chunk + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) == 0x3333333333333333; }
+
+/**
+ * Convert the 8 decimal digits loaded into @p chunk, the first one in the lowest byte
+ * @details		Combines the adjacent digits, then the pairs and then the quads with multiply-adds on the whole word.
+ */
+constexpr std::uint64_t
+parseEightDigits(std::uint64_t chunk) noexcept
+{
+	chunk -= 0x3030303030303030;
+	chunk = chunk * 10 + (chunk >> 8); // 2 digits in every other byte
+	return (
+		(chunk & 0x000000ff000000ff) * (100 + (1000000ull << 32)) +
+		((chunk >> 16) & 0x000000ff000000ff) * (1 + (10000ull << 32))
+	) >> 32;
+}
+
+/**
+ * Decimal counterpart of std::from_chars() that converts 8 digits per step
+ * @details		Accepts and reports exactly as std::from_chars() does. At most 16 digits are converted 8 at a time,
+ *				which cannot overflow, and the rest one at a time with overflow checks.
+ */
+template <Integer I>
+std::from_chars_result
+fromChars10(char const* const first, char const* const last, I& i) noexcept
+{
+	using U = std::make_unsigned_t<I>;
+	auto p{first};
+	bool negative{false};
+	if constexpr (SignedInteger<I>)
+		if (p != last && *p == '-') {
+			negative = true;
+			++p;
+		}
+
+	auto const digits{p};
+	std::uint64_t v{0};
+	for (std::uint64_t chunk; last - p >= 8 && p - digits < 16; p += 8) {
+		std::memcpy(&chunk, p, sizeof chunk);
+		if (!isEightDigits(chunk))
+			break;
+		v = v * 100000000 + parseEightDigits(chunk);
+	}
+	bool overflow{false};
+	for (unsigned d; p != last && (d = static_cast<unsigned char>(*p - '0')) < 10; ++p)
+		overflow = overflow || __builtin_mul_overflow(v, 10u, &v) || __builtin_add_overflow(v, d, &v);
+
+	if (p == digits)
+		return {first, std::errc::invalid_argument};
+	if (overflow || v > std::uint64_t{std::numeric_limits<U>::max() >> SignedInteger<I>} + negative)
+		return {p, std::errc::result_out_of_range};
+	i = static_cast<I>(negative ? U{0} - static_cast<U>(v) : static_cast<U>(v));
+	return {p, std::errc{}};
+}
+
+/**
+ * Check whether the characters from @p p to @p last could all be a part of a number, so that it may continue after them
+ */
+inline bool
+mayContinue(char const* p, char const* const last) noexcept
+{
+	for (; p != last; ++p)
+		if (!std::isalnum(static_cast<unsigned char>(*p)) && *p != '.' && *p != '+' && *p != '-')
+			return false;
+	return true;
+}
+
 }//namespace Stream::detail
 
 template <typename F>
@@ -68,12 +144,12 @@ TextInput::fromChars(Integer auto& i, unsigned const base)
 				throw Exception{std::make_error_code(std::errc::invalid_argument)};
 		}
 	}
-	return checkFromChars(std::from_chars(
-		reinterpret_cast<char const*>(getSource().begin()),
-		reinterpret_cast<char const*>(getSource().end()),
-		i,
-		base
-	));
+	auto const* first{reinterpret_cast<char const*>(getSource().begin())};
+	auto const* last{reinterpret_cast<char const*>(getSource().end())};
+	if constexpr (sizeof(I) <= sizeof(std::uint64_t) && std::endian::native == std::endian::little)
+		if (base == 10)
+			return checkFromChars(detail::fromChars10(first, last, i));
+	return checkFromChars(std::from_chars(first, last, i, base));
 }
 
 TextInput&
@@ -104,7 +180,7 @@ TextInput::fromChars(std::floating_point auto& f, std::chars_format const fmt, s
 		} break;
 		case std::chars_format::general: {
 			il += std::numeric_limits<F>::max_exponent10;
-			fl = precision ? precision : std::numeric_limits<F>::max_digits10;
+			fl = precision ? precision : std::numeric_limits<F>::max_digits10 + std::numeric_limits<F>::max_exponent10; // the shortest form may be fixed
 			el = std::max(std::size_t{2}, max_exponent10_digits10<F>);
 		} break;
 		case std::chars_format::hex: {
@@ -128,6 +204,61 @@ TextInput::fromChars(std::floating_point auto& f, std::chars_format const fmt, s
 	));
 }
 
+template <typename T>
+TextInput&
+TextInput::parseArray(std::span<T> const values, char const sep)
+requires Integer<T> || std::floating_point<T>
+{
+	bool const space{std::isspace(static_cast<unsigned char>(sep)) != 0}; // a run of any whitespace separates
+	auto const separates{[space, sep](char c) { return space ? std::isspace(static_cast<unsigned char>(c)) != 0 : c == sep; }};
+
+	for (std::size_t n{0}; n < values.size();) {
+		auto const* const first{reinterpret_cast<char const*>(getSource().begin())};
+		auto const* const last{reinterpret_cast<char const*>(getSource().end())};
+		auto const* p{first};
+		for (; n < values.size(); ++n) {
+			auto const* q{p};
+			if (n) {
+				if (q == last || !separates(*q++))
+					break;
+				if (space)
+					while (q != last && separates(*q))
+						++q;
+				if (q == last) // the run may go on after a refill
+					break;
+			}
+			std::from_chars_result r;
+			if constexpr (std::floating_point<T>)
+				r = std::from_chars(q, last, values[n]);
+			else if constexpr (sizeof(T) <= sizeof(std::uint64_t) && std::endian::native == std::endian::little)
+				r = detail::fromChars10(q, last, values[n]);
+			else
+				r = std::from_chars(q, last, values[n]);
+			if (detail::mayContinue(r.ec == std::errc{} ? r.ptr : q, last)) // a refill may complete the number or fix it
+				break;
+			if (r.ec != std::errc{}) [[unlikely]] {
+				getSource().consumed(p - first);
+				throw Exception{std::make_error_code(r.ec)};
+			}
+			p = r.ptr;
+		}
+		getSource().consumed(p - first);
+
+		if (n < values.size()) { // the number crossing the end of the data
+			if (n) {
+				char c;
+				if (*this >> c; !separates(c))
+					throw Exception{std::make_error_code(std::errc::invalid_argument)};
+				if (space)
+					while (provideAt(0) && separates(static_cast<char>(getSource()[0])))
+						getSource().consumed(1);
+			}
+			*this >> values[n++];
+		}
+	}
+	return *this;
+}
+
 TextOutput&
 TextOutput::operator<<(Pointer auto ptr)
 {
@@ -215,6 +346,41 @@ TextOutput::toChars(std::floating_point auto f, std::chars_format const fmt, std
 	));
 }
 
+template <typename T>
+TextOutput&
+TextOutput::writeArray(std::span<T const> const values, char const sep)
+requires Integer<T> || std::floating_point<T>
+{
+	std::size_t size;
+	if constexpr (std::floating_point<T>)
+		size = 1 + std::min(max_fixed_length<T>, max_scientific_length<T>);
+	else
+		size = 1 + CHAR_BIT * sizeof(T);
+
+	for (std::size_t n{0}, batch{256}; n < values.size();) {
+		if (auto const space{std::min(values.size() - n, batch) * size}; getSink().getSpaceSize() < space) {
+			if (batch == 1)
+				getSink().allocSomeMore(space - getSink().getSpaceSize());
+			else if (auto r{getSink().tryAllocSomeMore(space - getSink().getSpaceSize())}; !r) {
+				if (r.error() != make_error_code(Buffer::Exception::Code::BadAllocation))
+					throw Output::Exception{r.error()};
+				batch /= 2; // the buffer is capped by its policy, go on with smaller batches
+				continue;
+			}
+		}
+		auto* const first{reinterpret_cast<char*>(getSink().begin())};
+		auto* const last{reinterpret_cast<char*>(const_cast<std::byte*>(getSink().end()))};
+		auto* p{first};
+		for (; n < values.size() && static_cast<std::size_t>(last - p) >= size; ++n) {
+			if (n)
+				*p++ = sep;
+			p = std::to_chars(p, last, values[n]).ptr; // there is enough space
+		}
+		getSink().produced(p - first);
+	}
+	return *this;
+}
+
 TextOutput&
 TextOutput::operator<<(Char auto const* s)
 {
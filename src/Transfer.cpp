@@ -0,0 +1,222 @@
+#include "Stream/Transfer.hpp"
+#include "Stream/File.hpp"
+#include "Stream/Pipe.hpp"
+#include "Stream/Socket.hpp"
+#include <memory>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+
+namespace Stream {
+
+/**
+ * Largest request that is passed to a single system call
+ */
+static constexpr std::size_t MaxChunk{std::size_t{1} << 30};
+
+/**
+ * Size of the buffer used when there is no kernel shortcut
+ */
+static constexpr std::size_t CopyChunk{std::size_t{1} << 16};
+
+/**
+ * Throw the error of a kernel transfer as the exception of the side it most likely belongs to
+ */
+[[noreturn]] static void
+Throw(int error)
+{
+	auto const ec{std::make_error_code(static_cast<std::errc>(error))};
+	switch (error) {
+		case EPIPE:
+		case ENOSPC:
+		case EDQUOT:
+		case EFBIG:
+		case ECONNRESET:
+			throw Output::Exception{ec};
+		default:
+			throw Input::Exception{ec};
+	}
+}
+
+/**
+ * Call @p move until @p size bytes are moved or the source ends
+ * @param[in]	move Callable moving at most the given number of bytes, returning like the system call it wraps
+ * @param[out]	unsupported Set if the kernel refused the shortcut before anything was moved
+ * @return		Number of bytes moved
+ */
+static std::size_t
+Move(auto&& move, int in, int out, std::size_t size, bool& unsupported)
+{
+	std::size_t total{0};
+	while (total < size) {
+		auto const r{move(std::min(size - total, MaxChunk))};
+		if (r > 0) {
+			total += r;
+			continue;
+		}
+		if (r == 0) // end of the source
+			break;
+		switch (errno) {
+			case EINTR:
+				continue;
+			case EAGAIN: // non-blocking, wait for both ends before retrying
+				if (!IsNonBlocking(in) && !IsNonBlocking(out)) // the timeout of a blocking end expired
+					Throw(errno);
+				if (auto ec{Poll(in, POLLIN)})
+					throw Input::Exception{ec};
+				if (auto ec{Poll(out, POLLOUT)})
+					throw Output::Exception{ec};
+				continue;
+			case EINVAL:
+			case ENOSYS:
+			case EXDEV:
+			case EOPNOTSUPP:
+				if (!total) {
+					unsupported = true;
+					return 0;
+				}
+				[[fallthrough]];
+			default:
+				Throw(errno);
+		}
+	}
+	return total;
+}
+
+/**
+ * Splice from @p in to @p out through a temporary pipe, for sources that cannot be spliced or sent directly
+ */
+static std::size_t
+SpliceThroughPipe(int in, int out, std::size_t size, bool& unsupported)
+{
+	struct Intermediate {
+		int fd[2]{-1, -1};
+
+		~Intermediate()
+		{
+			if (fd[0] != -1)
+				::close(fd[0]);
+			if (fd[1] != -1)
+				::close(fd[1]);
+		}
+	} pipe;
+
+	if (::pipe2(pipe.fd, O_CLOEXEC) == -1) {
+		unsupported = true;
+		return 0;
+	}
+
+	std::size_t total{0};
+	while (total < size) {
+		bool refused{false};
+		// a single splice per round, the pipe holds a limited number of buffers of the source and filling it further
+		// would wait for the draining that follows
+		bool filled{false};
+		auto const moved{Move([&](std::size_t n) -> ::ssize_t {
+			if (filled)
+				return 0;
+			auto const r{::splice(in, nullptr, pipe.fd[1], nullptr, n, SPLICE_F_MOVE)};
+			filled = r > 0;
+			return r;
+		}, in, pipe.fd[1], size - total, refused)};
+		if (refused) {
+			unsupported = true;
+			return total;
+		}
+		if (!moved)
+			break;
+		for (std::size_t drained{0}; drained < moved;) {
+			std::size_t r;
+			try {
+				r = Move([&](std::size_t n) { return ::splice(pipe.fd[0], nullptr, out, nullptr, n, SPLICE_F_MOVE); }, pipe.fd[0], out, moved - drained, refused);
+			} catch (Input::Exception const& exc) { // reading the own pipe does not fail, it is the sink
+				throw Output::Exception{exc.code()};
+			}
+			if (refused || !r) // the data in the pipe can not be given back to the source
+				throw Output::Exception{std::make_error_code(refused ? std::errc::invalid_argument : std::errc::broken_pipe)};
+			drained += r;
+		}
+		total += moved;
+	}
+	return total;
+}
+
+static std::size_t
+Copy(Input& input, Output& output, std::size_t size)
+{
+	auto const buffer{std::make_unique<std::byte[]>(std::min(size, CopyChunk))};
+	std::size_t total{0};
+	while (total < size) {
+		auto r{input.tryReadSome(buffer.get(), std::min(size - total, CopyChunk))};
+		if (!r) {
+			if (r.error() == std::make_error_code(std::errc::no_message_available))
+				break;
+			throw Input::Exception{r.error()};
+		}
+		output.write(buffer.get(), *r);
+		total += *r;
+	}
+	return total;
+}
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/copy_file_range.2.html">copy_file_range()</a>
+ * @see		<a href="https://man7.org/linux/man-pages/man2/sendfile.2.html">sendfile()</a>
+ * @see		<a href="https://man7.org/linux/man-pages/man2/splice.2.html">splice()</a>
+ */
+std::size_t
+Transfer(Input& input, Output& output, std::size_t size)
+{
+	enum class Kind {
+		None,
+		File,
+		Pipe,
+		Socket
+	};
+
+	auto [in, inKind]{[&]() -> std::pair<int, Kind> {
+		if (auto* file{dynamic_cast<File*>(&input)})
+			return {file->mDescriptor, Kind::File};
+		if (auto* pipe{dynamic_cast<Pipe*>(&input)})
+			return {pipe->mReadDescriptor, Kind::Pipe};
+		if (auto* socket{dynamic_cast<Socket*>(&input)})
+			return {socket->mDescriptor, Kind::Socket};
+		return {-1, Kind::None};
+	}()};
+
+	auto [out, outKind]{[&]() -> std::pair<int, Kind> {
+		if (auto* file{dynamic_cast<File*>(&output)})
+			return {file->mDescriptor, Kind::File};
+		if (auto* pipe{dynamic_cast<Pipe*>(&output)})
+			return {pipe->mWriteDescriptor, Kind::Pipe};
+		if (auto* socket{dynamic_cast<Socket*>(&output)})
+			return {socket->mDescriptor, Kind::Socket};
+		return {-1, Kind::None};
+	}()};
+
+	std::size_t total{0};
+	bool unsupported{inKind == Kind::None || outKind == Kind::None};
+
+	if (!unsupported && inKind == Kind::File && outKind == Kind::File) {
+		total = Move([&](std::size_t n) { return ::copy_file_range(in, nullptr, out, nullptr, n, 0); }, in, out, size, unsupported);
+		if (unsupported) { // e.g. across file systems on older kernels
+			unsupported = false;
+			total = Move([&](std::size_t n) { return ::sendfile(out, in, nullptr, n); }, in, out, size, unsupported);
+		}
+	} else if (!unsupported && (inKind == Kind::Pipe || outKind == Kind::Pipe)) {
+		total = Move([&](std::size_t n) { return ::splice(in, nullptr, out, nullptr, n, SPLICE_F_MOVE); }, in, out, size, unsupported);
+	} else if (!unsupported && inKind == Kind::File) {
+		total = Move([&](std::size_t n) { return ::sendfile(out, in, nullptr, n); }, in, out, size, unsupported);
+	} else if (!unsupported) {
+		total = SpliceThroughPipe(in, out, size, unsupported);
+	}
+
+	if (unsupported)
+		total += Copy(input, output, size - total);
+	return total;
+}
+
+}//namespace Stream
@@ -0,0 +1,448 @@
+#include "Stream/UringFile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+namespace Stream {
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/io_uring_setup.2.html">io_uring_setup()</a>
+ * @details	Opens the file like File does and sets up an io_uring instance with @p depth entries.
+ *			If a system call fails, it throws a File::Exception.
+ */
+UringFile::UringFile(std::string const& name, File::Mode mode, unsigned depth, std::size_t blockSize)
+		: Input{false}
+		, Output{false}
+		, mDepth{std::max(depth, 1u)}
+		, mBlockSize{std::max<std::size_t>(blockSize, 1)}
+{
+	auto fail{[&](int error) {
+		release();
+		throw File::Exception{std::make_error_code(static_cast<std::errc>(error)), name};
+	}};
+
+	mDescriptor = ::open(name.c_str(), static_cast<int>(mode), S_IWUSR | S_IRUSR | S_IRGRP | S_IROTH);
+	if (mDescriptor == -1)
+		fail(errno);
+
+	// writes are issued at explicit offsets, the end of the file is looked up when writing starts
+	if (static_cast<int>(mode) & O_APPEND) {
+		mAppend = true;
+		if (::fcntl(mDescriptor, F_SETFL, ::fcntl(mDescriptor, F_GETFL) & ~O_APPEND) == -1)
+			fail(errno);
+	}
+	if ((mOffset = ::lseek(mDescriptor, 0, SEEK_CUR)) == -1)
+		mOffset = 0;
+
+	::io_uring_params params{};
+	mRing = static_cast<int>(::syscall(__NR_io_uring_setup, mDepth, &params));
+	if (mRing == -1)
+		fail(errno);
+	if (!(params.features & IORING_FEAT_SINGLE_MMAP))
+		fail(ENOSYS);
+
+	mRingMemorySize = std::max<std::size_t>(
+		params.sq_off.array + params.sq_entries * sizeof(unsigned),
+		params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe));
+	mRingMemory = ::mmap(nullptr, mRingMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_SQ_RING);
+	if (mRingMemory == MAP_FAILED) {
+		mRingMemory = nullptr;
+		fail(errno);
+	}
+	mEntriesSize = params.sq_entries * sizeof(::io_uring_sqe);
+	auto* entries{::mmap(nullptr, mEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_SQES)};
+	if (entries == MAP_FAILED)
+		fail(errno);
+	mEntries = static_cast<::io_uring_sqe*>(entries);
+
+	auto* ring{static_cast<std::byte*>(mRingMemory)};
+	mSqHead = reinterpret_cast<unsigned*>(ring + params.sq_off.head);
+	mSqTail = reinterpret_cast<unsigned*>(ring + params.sq_off.tail);
+	mSqArray = reinterpret_cast<unsigned*>(ring + params.sq_off.array);
+	mSqMask = *reinterpret_cast<unsigned*>(ring + params.sq_off.ring_mask);
+	mCqHead = reinterpret_cast<unsigned*>(ring + params.cq_off.head);
+	mCqTail = reinterpret_cast<unsigned*>(ring + params.cq_off.tail);
+	mCqEntries = reinterpret_cast<::io_uring_cqe*>(ring + params.cq_off.cqes);
+	mCqMask = *reinterpret_cast<unsigned*>(ring + params.cq_off.ring_mask);
+
+	mMemory = std::make_unique<std::byte[]>(mDepth * mBlockSize);
+	mBlocks = std::make_unique<Block[]>(mDepth);
+	for (unsigned i{0}; i < mDepth; ++i)
+		mBlocks[i] = {mMemory.get() + i * mBlockSize, 0, 0, 0, 0, false};
+}
+
+UringFile::UringFile(UringFile&& other) noexcept
+		: Input{false}
+		, Output{false}
+{ swap(*this, other); }
+
+void
+swap(UringFile& a, UringFile& b) noexcept
+{
+	std::swap(a.mDescriptor, b.mDescriptor);
+	std::swap(a.mRing, b.mRing);
+	std::swap(a.mRingMemory, b.mRingMemory);
+	std::swap(a.mRingMemorySize, b.mRingMemorySize);
+	std::swap(a.mEntries, b.mEntries);
+	std::swap(a.mEntriesSize, b.mEntriesSize);
+	std::swap(a.mSqHead, b.mSqHead);
+	std::swap(a.mSqTail, b.mSqTail);
+	std::swap(a.mSqArray, b.mSqArray);
+	std::swap(a.mSqMask, b.mSqMask);
+	std::swap(a.mCqHead, b.mCqHead);
+	std::swap(a.mCqTail, b.mCqTail);
+	std::swap(a.mCqEntries, b.mCqEntries);
+	std::swap(a.mCqMask, b.mCqMask);
+	std::swap(a.mUnsubmitted, b.mUnsubmitted);
+	std::swap(a.mMemory, b.mMemory);
+	std::swap(a.mBlocks, b.mBlocks);
+	std::swap(a.mDepth, b.mDepth);
+	std::swap(a.mHead, b.mHead);
+	std::swap(a.mUsed, b.mUsed);
+	std::swap(a.mBlockSize, b.mBlockSize);
+	std::swap(a.mDirection, b.mDirection);
+	std::swap(a.mAppend, b.mAppend);
+	std::swap(a.mOffset, b.mOffset);
+	std::swap(a.mSubmitOffset, b.mSubmitOffset);
+	std::swap(a.mWriteError, b.mWriteError);
+}
+
+UringFile&
+UringFile::operator=(UringFile&& other) noexcept
+{
+	swap(*this, other);
+	return *this;
+}
+
+/**
+ * @details	Waits for the blocks in flight, writes the pending blocks and closes the file resource.
+ *			If an error occurs, it writes the description of the error to the <b>standard error stream</b>.
+ */
+UringFile::~UringFile()
+{
+	if (mRing != -1 && mDirection == Direction::Write) {
+		if (auto ec{settle()})
+			LOG_ERR(ec.message());
+		if (mWriteError)
+			LOG_ERR(mWriteError.message());
+	}
+	if (mDescriptor != -1 && ::fsync(mDescriptor) == -1)
+		LOG_ERR(::strerror(errno));
+	release();
+}
+
+void
+UringFile::release() noexcept
+{
+	if (mEntries)
+		::munmap(mEntries, mEntriesSize);
+	if (mRingMemory)
+		::munmap(mRingMemory, mRingMemorySize);
+	if (mRing != -1)
+		::close(mRing);
+	if (mDescriptor != -1 && ::close(mDescriptor) == -1)
+		LOG_ERR(::strerror(errno));
+	mEntries = nullptr;
+	mRingMemory = nullptr;
+	mRing = -1;
+	mDescriptor = -1;
+}
+
+void
+UringFile::prepareEntry(unsigned index, unsigned char opcode) noexcept
+{
+	auto& block{mBlocks[index]};
+	auto tail{*mSqTail};
+	auto& entry{mEntries[tail & mSqMask]};
+	std::memset(&entry, 0, sizeof entry);
+	entry.opcode = opcode;
+	entry.fd = mDescriptor;
+	entry.off = block.mOffset;
+	entry.addr = reinterpret_cast<std::uintptr_t>(block.mData);
+	entry.len = static_cast<unsigned>(block.mSize);
+	entry.user_data = index;
+	mSqArray[tail & mSqMask] = tail & mSqMask;
+	std::atomic_ref<unsigned>{*mSqTail}.store(tail + 1, std::memory_order_release);
+	block.mPending = true;
+	++mUnsubmitted;
+}
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/io_uring_enter.2.html">io_uring_enter()</a>
+ */
+std::error_code
+UringFile::submit(unsigned wait) noexcept
+{
+	auto& probe{mDirection == Direction::Write ? getOutputProbe() : getInputProbe()};
+	while (true) {
+		probe.syscall();
+		auto r{::syscall(__NR_io_uring_enter, mRing, mUnsubmitted, wait, wait ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0)};
+		if (r >= 0) {
+			mUnsubmitted -= static_cast<unsigned>(r);
+			return {};
+		}
+		if (errno != EINTR)
+			return std::make_error_code(static_cast<std::errc>(errno));
+	}
+}
+
+void
+UringFile::reap() noexcept
+{
+	auto head{*mCqHead};
+	auto const tail{std::atomic_ref<unsigned>{*mCqTail}.load(std::memory_order_acquire)};
+	for (; head != tail; ++head) {
+		auto const& completion{mCqEntries[head & mCqMask]};
+		auto& block{mBlocks[completion.user_data]};
+		block.mResult = completion.res;
+		block.mPending = false;
+	}
+	std::atomic_ref<unsigned>{*mCqHead}.store(head, std::memory_order_release);
+}
+
+std::error_code
+UringFile::waitFor(unsigned index) noexcept
+{
+	while (true) {
+		reap();
+		if (!mBlocks[index].mPending)
+			return {};
+		if (auto ec{submit(1)})
+			return ec;
+	}
+}
+
+/**
+ * @details	Finishes a write that the kernel completed partially or asked to retry with <b>pwrite()</b>.
+ */
+std::error_code
+UringFile::complete(Block& block) noexcept
+{
+	std::error_code ec;
+	std::size_t done{0};
+	if (block.mResult >= 0)
+		done = static_cast<std::size_t>(block.mResult);
+	else if (block.mResult != -EAGAIN && block.mResult != -EINTR)
+		ec = std::make_error_code(static_cast<std::errc>(-block.mResult));
+
+	while (!ec && done < block.mSize) {
+		getOutputProbe().syscall();
+		auto r{::pwrite(mDescriptor, block.mData + done, block.mSize - done, block.mOffset + static_cast<::off_t>(done))};
+		if (r >= 0)
+			done += r;
+		else if (errno != EINTR)
+			ec = std::make_error_code(static_cast<std::errc>(errno));
+	}
+	block.mSize = 0;
+	return ec;
+}
+
+/**
+ * @details	Waits for every block in flight. Read-ahead blocks are discarded,
+ *			the partially filled write block is written and write errors are kept for the next write or flush.
+ */
+std::error_code
+UringFile::settle() noexcept
+{
+	if (mDirection == Direction::Write && mUsed < mDepth) {
+		auto const index{(mHead + mUsed) % mDepth};
+		if (mBlocks[index].mSize) {
+			prepareEntry(index, IORING_OP_WRITE);
+			++mUsed;
+		}
+	}
+
+	for (; mUsed; mHead = (mHead + 1) % mDepth, --mUsed) {
+		auto& block{mBlocks[mHead]};
+		if (auto ec{waitFor(mHead)})
+			return ec;
+		if (mDirection == Direction::Write) {
+			if (auto ec{complete(block)}; ec && !mWriteError)
+				mWriteError = ec;
+		}
+	}
+	mHead = 0;
+	return {};
+}
+
+void
+UringFile::readAhead() noexcept
+{
+	for (; mUsed < mDepth; ++mUsed) {
+		auto const index{(mHead + mUsed) % mDepth};
+		auto& block{mBlocks[index]};
+		block.mOffset = mSubmitOffset;
+		block.mSize = mBlockSize;
+		block.mPos = 0;
+		prepareEntry(index, IORING_OP_READ);
+		mSubmitOffset += static_cast<::off_t>(mBlockSize);
+	}
+	if (mUnsubmitted)
+		submit(0); // an error is reported when the block is waited for
+}
+
+std::error_code
+UringFile::setDirection(Direction direction) noexcept
+{
+	if (mDirection == direction)
+		return {};
+
+	if (auto ec{settle()})
+		return ec;
+
+	if (direction == Direction::Write && mAppend) {
+		struct stat fileStatus;
+		if (::fstat(mDescriptor, &fileStatus) == -1)
+			return std::make_error_code(static_cast<std::errc>(errno));
+		mOffset = fileStatus.st_size;
+	}
+	mSubmitOffset = mOffset;
+	mDirection = direction;
+	return {};
+}
+
+std::size_t
+UringFile::readBytes(std::byte* dest, std::size_t size)
+{
+	auto r{tryReadBytes(dest, size)};
+	if (!r) [[unlikely]]
+		throw Input::Exception{r.error()};
+	return *r;
+}
+
+std::size_t
+UringFile::writeBytes(std::byte const* src, std::size_t size)
+{
+	auto r{tryWriteBytes(src, size)};
+	if (!r) [[unlikely]]
+		throw Output::Exception{r.error()};
+	return *r;
+}
+
+/**
+ * @details	Copies from the oldest read-ahead block and refills the blocks that are consumed.
+ *			A short read restarts the read-ahead at the position it stopped.
+ */
+std::expected<std::size_t, std::error_code>
+UringFile::tryReadBytes(std::byte* dest, std::size_t size)
+{
+	if (auto ec{setDirection(Direction::Read)})
+		return std::unexpected{ec};
+
+	readAhead();
+	while (true) {
+		if (auto ec{waitFor(mHead)})
+			return std::unexpected{ec};
+
+		auto& block{mBlocks[mHead]};
+		if (block.mResult == -EAGAIN || block.mResult == -EINTR) {
+			prepareEntry(mHead, IORING_OP_READ);
+			continue;
+		}
+		if (block.mResult <= 0) {
+			auto ec{block.mResult
+				? std::make_error_code(static_cast<std::errc>(-block.mResult))
+				: std::make_error_code(std::errc::no_message_available)};
+			settle();
+			mSubmitOffset = mOffset;
+			return std::unexpected{ec};
+		}
+
+		auto const result{static_cast<std::size_t>(block.mResult)};
+		auto const n{std::min(size, result - block.mPos)};
+		std::memcpy(dest, block.mData + block.mPos, n);
+		block.mPos += n;
+		mOffset += static_cast<::off_t>(n);
+
+		if (block.mPos == result) {
+			mHead = (mHead + 1) % mDepth;
+			--mUsed;
+			if (result < block.mSize) { // the blocks in flight do not follow this one
+				settle();
+				mSubmitOffset = mOffset;
+			}
+			readAhead();
+		}
+		return n;
+	}
+}
+
+/**
+ * @details	Copies into the block being filled and queues it once it is full.
+ *			Queued blocks are submitted in batches of half the depth.
+ */
+std::expected<std::size_t, std::error_code>
+UringFile::tryWriteBytes(std::byte const* src, std::size_t size)
+{
+	if (auto ec{setDirection(Direction::Write)})
+		return std::unexpected{ec};
+
+	if (mWriteError) // the file has a hole, writing on would hide it
+		return std::unexpected{mWriteError};
+
+	if (mUsed == mDepth) {
+		if (auto ec{waitFor(mHead)})
+			return std::unexpected{ec};
+		auto ec{complete(mBlocks[mHead])};
+		mHead = (mHead + 1) % mDepth;
+		--mUsed;
+		if (ec) {
+			mWriteError = ec;
+			return std::unexpected{ec};
+		}
+	}
+
+	auto const index{(mHead + mUsed) % mDepth};
+	auto& block{mBlocks[index]};
+	if (!block.mSize)
+		block.mOffset = mOffset;
+
+	auto const n{std::min(size, mBlockSize - block.mSize)};
+	std::memcpy(block.mData + block.mSize, src, n);
+	block.mSize += n;
+	mOffset += static_cast<::off_t>(n);
+
+	if (block.mSize == mBlockSize) {
+		prepareEntry(index, IORING_OP_WRITE);
+		++mUsed;
+		if (mUnsubmitted >= std::max(mDepth / 2, 1u))
+			if (auto ec{submit(0)})
+				return std::unexpected{ec};
+	}
+	return n;
+}
+
+/**
+ * @see		<a href="https://man7.org/linux/man-pages/man2/fdatasync.2.html">fdatasync()</a>
+ * @details	Writes the pending blocks, waits for them and reports the first write error, if any, on every call.
+ */
+void
+UringFile::flush()
+{
+	if (mDirection == Direction::Write) {
+		if (auto ec{settle()})
+			throw Output::Exception{ec};
+		if (mWriteError)
+			throw Output::Exception{mWriteError};
+	}
+	getOutputProbe().syscall();
+	if (::fdatasync(mDescriptor) == -1)
+		throw Output::Exception{std::make_error_code(static_cast<std::errc>(errno))};
+}
+
+unsigned
+UringFile::getDepth() const noexcept
+{ return mDepth; }
+
+std::size_t
+UringFile::getBlockSize() const noexcept
+{ return mBlockSize; }
+
+}//namespace Stream
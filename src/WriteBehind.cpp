@@ -0,0 +1,141 @@
+#include "Stream/WriteBehind.hpp"
+
+
+namespace Stream {
+
+WriteBehindOutput::WriteBehindOutput(std::size_t blockSize, std::size_t depth)
+		: mBlockSize{blockSize}
+		, mBlocks(depth)
+{
+	for (auto& block : mBlocks)
+		block = {std::make_unique_for_overwrite<std::byte[]>(blockSize), blockSize};
+	present();
+}
+
+WriteBehindOutput::~WriteBehindOutput()
+{
+	try {
+		queue();
+		mInterrupt.trigger(); // the sink is not waited for, the thread could wait forever
+		if (auto ec{wait(0)})
+			throw Output::Exception{ec};
+	} catch (std::system_error const& exc) {
+		// Nothing can be done
+		LOG_ERR(exc.what())
+	}
+
+	{
+		std::lock_guard lock{mMutex};
+		mStopped = true;
+	}
+	mCondition.notify_all();
+	if (mThread.joinable())
+		mThread.join();
+	// nothing is left for ~BufferOutput() to write
+	mOutputDataBeg = mOutputDataEnd = nullptr;
+	mOutputEnd = nullptr;
+}
+
+std::expected<std::size_t, std::error_code>
+WriteBehindOutput::tryAllocBytes(std::size_t const size)
+{
+	queue();
+	if (auto ec{wait(mBlocks.size() - 1)}) // the next block is free once the thread is at most a block short of the producer
+		return std::unexpected{ec};
+
+	auto& block{mBlocks[mQueued % mBlocks.size()]};
+	if (block.mCapacity < size || (block.mCapacity > mBlockSize && size <= mBlockSize)) { // grow for a large allocation, or shrink back after it
+		auto const capacity{std::max(size, mBlockSize)};
+		try {
+			block = {std::make_unique_for_overwrite<std::byte[]>(capacity), capacity};
+		} catch (std::bad_alloc const&) {
+			return std::unexpected{make_error_code(Buffer::Exception::Code::BadAllocation)};
+		}
+	}
+	present();
+	return std::min(size, block.mCapacity);
+}
+
+void
+WriteBehindOutput::flush()
+{
+	queue();
+	if (auto ec{wait(0)})
+		throw Output::Exception{ec};
+	present();
+}
+
+void
+WriteBehindOutput::run() noexcept
+{
+	Interrupt::Install(&mInterrupt);
+	for (;;) {
+		Block* block;
+		{
+			std::unique_lock lock{mMutex};
+			mCondition.wait(lock, [this] { return mStopped || mWritten < mQueued; });
+			if (mWritten == mQueued) // stopped with nothing left to write
+				return;
+			block = &mBlocks[mWritten % mBlocks.size()];
+		}
+
+		std::error_code ec;
+		try {
+			getSink().write(block->mData.get(), block->mSize);
+		} catch (Output::Exception const& exc) {
+			ec = exc.code();
+		}
+
+		{
+			std::lock_guard lock{mMutex};
+			if (ec)
+				mError = ec;
+			else
+				++mWritten;
+		}
+		mCondition.notify_all();
+		if (ec)
+			return;
+	}
+}
+
+void
+WriteBehindOutput::queue()
+{
+	auto& block{mBlocks[mQueued % mBlocks.size()]};
+	if (!mOutputDataEnd || mOutputDataEnd == block.mData.get()) // queued already, or nothing is produced
+		return;
+	block.mSize = mOutputDataEnd - block.mData.get();
+
+	if (!mThread.joinable()) // the sink is linked by now
+		mThread = std::jthread{[this] { run(); }};
+	{
+		std::lock_guard lock{mMutex};
+		++mQueued;
+	}
+	mCondition.notify_all();
+	mOutputDataBeg = mOutputDataEnd = nullptr;
+	mOutputEnd = nullptr;
+}
+
+std::error_code
+WriteBehindOutput::wait(std::size_t const count) noexcept
+{
+	std::unique_lock lock{mMutex};
+	mCondition.wait(lock, [this, count] { return mError || mQueued - mWritten <= count; });
+	return mError;
+}
+
+void
+WriteBehindOutput::present() noexcept
+{
+	auto& block{mBlocks[mQueued % mBlocks.size()]};
+	mOutputDataBeg = mOutputDataEnd = block.mData.get();
+	mOutputEnd = block.mData.get() + block.mCapacity;
+}
+
+std::size_t
+WriteBehindOutput::getDepth() const noexcept
+{ return mBlocks.size(); }
+
+}//namespace Stream
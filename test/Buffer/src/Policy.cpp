@@ -0,0 +1,65 @@
+#include <Stream/Buffer.hpp>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+int main()
+{
+	{ // geometric growth
+		Stream::BufferPolicy policy;
+		assert(policy.grow(16, 17) == 32);
+		assert(policy.grow(16, 100) == 128);
+		assert(policy.grow(0, 100) == 100);
+		policy.growthFactor = 1;
+		assert(policy.grow(16, 100) == 100);
+		policy.growthFactor = 1.5;
+		policy.maxSize = 1000;
+		assert(policy.grow(100, 200) == 225);
+		assert(policy.grow(900, 950) == 1000);
+		assert(policy.grow(900, 1001) == 0);
+	}
+
+	std::string data(1 << 16, '\0');
+	for (std::size_t i{0}; i < data.size(); ++i)
+		data[i] = static_cast<char>(i % 251);
+
+	{ // input grows up to the limit and shrinks back once the large message is consumed
+		Stream::BufferInput source(data.data(), data.size());
+		Stream::BufferInput input(64);
+		input.setInputPolicy({.maxSize = 1 << 14, .highWaterMark = 256});
+		source > input;
+
+		assert(input.provide(10'000) == 10'000);
+		assert(input.getInputCapacity() == 16384);
+		assert(!std::memcmp(input.begin(), data.data(), 10'000));
+		input.consumed(10'000);
+
+		auto r{input.tryProvide(20'000)};
+		assert(!r && r.error() == make_error_code(Stream::Buffer::Exception::Code::BadAllocation));
+
+		input.consumed(input.getDataSize());
+		assert(input.provide(100) == 100);
+		assert(input.getInputCapacity() == 256);
+	}
+
+	{ // output shrinks back once the large message is written
+		std::string copy(data.size(), '\0');
+		Stream::BufferOutput memory(copy.data(), copy.size());
+		Stream::BufferOutput output(64);
+		output.setOutputPolicy({.highWaterMark = 128});
+		memory < output;
+
+		assert(output.alloc(1000) == 1000);
+		assert(output.getOutputCapacity() == 1024);
+		std::memcpy(output.begin(), data.data(), 1000);
+		output.produced(1000);
+
+		output << nullptr;
+		assert(output.getOutputCapacity() == 128);
+		output.write(data.data() + 1000, 10);
+		output << nullptr;
+		assert(!std::memcmp(copy.data(), data.data(), 1010));
+	}
+
+	return 0;
+}
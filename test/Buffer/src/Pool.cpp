@@ -0,0 +1,174 @@
+#include <Stream/Buffer.hpp>
+#include <Stream/BufferPool.hpp>
+#include <cassert>
+#include <cstring>
+#include <optional>
+#include <semaphore>
+#include <string>
+#include <thread>
+
+/**
+ * Memory resource counting the allocations it forwards
+ */
+class Counting : public std::pmr::memory_resource {
+
+	void*
+	do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		auto* p{std::pmr::new_delete_resource()->allocate(bytes, alignment)};
+		++allocations;
+		return p;
+	}
+
+	void
+	do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{ std::pmr::new_delete_resource()->deallocate(p, bytes, alignment); }
+
+	bool
+	do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+	{ return this == &other; }
+
+public:
+
+	std::size_t allocations{0};
+
+};
+
+/**
+ * Source that has no data on the first attempt, recording what the pool caches while it is waited for
+ */
+class Later : public Stream::Input {
+	bool mReady{false};
+
+	std::size_t
+	readBytes(std::byte* dest, std::size_t) override
+	{
+		if (!mReady)
+			return 0;
+		*dest = std::byte{'x'};
+		return 1;
+	}
+
+	std::error_code
+	waitReadable(unsigned) noexcept override
+	{
+		cachedWhileWaiting = pool.getCachedSize();
+		mReady = true;
+		return {};
+	}
+
+public:
+
+	Stream::BufferPool const& pool;
+	std::size_t cachedWhileWaiting{0};
+
+	explicit
+	Later(Stream::BufferPool const& pool) noexcept
+			: pool{pool}
+	{}
+
+};
+
+int main()
+{
+	assert(Stream::BufferPool::GetClassSize(1) == 0);
+	assert(Stream::BufferPool::GetClassSize(Stream::BufferPool::MinClassSize - 1) == 0);
+	assert(Stream::BufferPool::GetClassSize(Stream::BufferPool::MinClassSize) == Stream::BufferPool::MinClassSize);
+	assert(Stream::BufferPool::GetClassSize(5000) == 8192);
+	assert(Stream::BufferPool::GetClassSize(Stream::BufferPool::MaxClassSize + 1) == 0);
+
+	std::string const data(20'000, 'x');
+	Stream::BufferPool pool;
+
+	{ // idle buffers give their memory back and borrow it again when data arrives
+		Stream::BufferInput source(data.data(), data.size());
+		Stream::BufferInput input(4096, &pool);
+		input.setInputPolicy({.releaseEmpty = true});
+		source > input;
+		assert(pool.getCachedSize() == 4096);
+
+		assert(input.provide(100) == 100);
+		assert(pool.getCachedSize() == 0);
+		assert(!std::memcmp(input.begin(), data.data(), 100));
+		auto const* consumed{input.begin()};
+		input.consumed(input.getDataSize());
+		assert(pool.getCachedSize() == 0); // the consumed data is still readable until the next request
+		assert(!std::memcmp(consumed, data.data(), 100));
+
+		Stream::BufferInput ended(data.data(), 0);
+		ended > input;
+		assert(!input.tryProvideSome(1));
+		assert(pool.getCachedSize() == 4096);
+
+		std::string sink(data.size(), '\0');
+		Stream::BufferOutput memory(sink.data(), sink.size());
+		Stream::BufferOutput output(4096, &pool);
+		output.setOutputPolicy({.releaseEmpty = true});
+		memory < output;
+		assert(pool.getCachedSize() == 4096);
+
+		output.write(data.data(), 1000);
+		assert(pool.getCachedSize() == 0);
+		output << nullptr;
+		assert(pool.getCachedSize() == 4096);
+		assert(!std::memcmp(sink.data(), data.data(), 1000));
+		output << nullptr;
+		assert(output.getOutputCapacity() == 4096);
+	}
+
+	{ // an idle source is waited for with the memory given back
+		Later later{pool};
+		Stream::BufferInput input(4096, &pool);
+		input.setInputPolicy({.releaseEmpty = true});
+		later > input;
+		assert(input.provide(1) == 1);
+		assert(later.cachedWhileWaiting == 4096);
+		assert(pool.getCachedSize() == 0);
+	}
+
+	std::jthread{[&] { // blocks are cached per thread
+		assert(pool.getCachedSize() == 0);
+		Stream::Buffer buffer(4096, &pool);
+		buffer.setInputPolicy({.releaseEmpty = true});
+		assert(pool.getCachedSize() == 4096);
+	}};
+	assert(pool.getCachedSize() == 4096);
+
+	pool.trim();
+	assert(pool.getCachedSize() == 0);
+
+	{ // small requests are not rounded up to a pooled block
+		Counting upstream;
+		Stream::BufferPool small{64, &upstream};
+		small.deallocate(small.allocate(100), 100);
+		assert(small.getCachedSize() == 0);
+		small.deallocate(small.allocate(100), 100);
+		assert(upstream.allocations == 2);
+	}
+
+	{ // a pool constructed where another was destroyed does not see the blocks the other threads cached for that one
+		Counting first, second;
+		std::optional<Stream::BufferPool> pool{std::in_place, 64, &first};
+		std::binary_semaphore cached{0}, replaced{0};
+		std::jthread thread{[&] {
+			pool->deallocate(pool->allocate(4096), 4096);
+			assert(pool->getCachedSize() == 4096);
+			cached.release();
+			replaced.acquire();
+			assert(pool->getCachedSize() == 0);
+			pool->deallocate(pool->allocate(4096), 4096);
+			assert(second.allocations == 1);
+		}};
+		cached.acquire();
+		auto const* address{&*pool};
+		pool.reset();
+		pool.emplace(64, &second);
+		assert(&*pool == address);
+		replaced.release();
+		thread.join();
+		pool.reset();
+		assert(first.allocations == 1);
+	}
+
+	return 0;
+}
@@ -0,0 +1,72 @@
+#include <Stream/Buffer.hpp>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+/**
+ * Memory resource that counts the memory it hands out
+ */
+class Counting : public std::pmr::memory_resource {
+	std::pmr::memory_resource* mUpstream;
+
+	void*
+	do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		auto* p{mUpstream->allocate(bytes, alignment)};
+		++allocations;
+		allocated += bytes;
+		return p;
+	}
+
+	void
+	do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+		allocated -= bytes;
+		mUpstream->deallocate(p, bytes, alignment);
+	}
+
+	bool
+	do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+	{ return this == &other; }
+
+public:
+
+	unsigned allocations{0};
+	std::size_t allocated{0};
+
+	explicit
+	Counting(std::pmr::memory_resource* upstream) noexcept
+			: mUpstream{upstream}
+	{}
+
+};
+
+int main()
+{
+	std::string const data(1000, 'x');
+	std::byte arena[4096];
+	std::pmr::monotonic_buffer_resource monotonic{arena, sizeof arena, std::pmr::null_memory_resource()};
+	Counting counting{&monotonic};
+
+	{
+		Stream::BufferInput source(data.data(), data.size());
+		Stream::BufferInput input(16, &counting);
+		source > input;
+		assert(input.getInputResource() == &counting);
+		assert(counting.allocations == 1 && counting.allocated == 16);
+
+		assert(input.provide(100) == 100); // growth comes from the same resource
+		assert(counting.allocations == 2 && counting.allocated == 128);
+		assert(!std::memcmp(input.begin(), data.data(), 100));
+
+		auto r{input.tryProvide(5000)}; // more than the arena holds
+		assert(!r && r.error() == make_error_code(Stream::Buffer::Exception::Code::BadAllocation));
+
+		Stream::BufferOutput output(16, &counting);
+		assert(output.alloc(64) == 64);
+		assert(counting.allocations == 4 && counting.allocated == 128 + 64);
+	}
+	assert(counting.allocated == 0);
+
+	return 0;
+}
@@ -0,0 +1,38 @@
+#include <Stream/Text.hpp>
+#include <cassert>
+
+int main()
+{
+	using namespace std::string_view_literals;
+	auto sv{"12 3.5"sv};
+	Stream::BufferInput buffer(sv.data(), sv.size());
+	Stream::TextInput text;
+	buffer > text;
+
+	char c[4];
+	auto r{buffer.tryRead(c, 3)};
+	assert(r && *r == 3);
+	r = buffer.tryRead(c, 4);
+	assert(r && *r == 3);
+	r = buffer.tryRead(c, 1);
+	assert(!r && r.error() == std::make_error_code(std::errc::no_message_available));
+
+	Stream::BufferInput source(sv.data(), sv.size());
+	source > text;
+	int i;
+	double d;
+	text >> i >> c[0] >> d;
+	assert(i == 12 && d == 3.5);
+
+	auto p{buffer.tryProvide(1)};
+	assert(!p && p.error() == std::make_error_code(std::errc::no_message_available));
+
+	char sink[4];
+	Stream::BufferOutput output(sink, sizeof sink);
+	auto w{output.tryWrite("abcdef", 6)};
+	assert(w && *w == 4);
+	w = output.tryWrite("ef", 2);
+	assert(!w && w.error() == std::make_error_code(std::errc::no_space_on_device));
+
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include <Stream/Buffer.hpp>
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * In-memory source that signals for retry before every read
+ */
+class Sparse : public Stream::Input {
+	char const* mData;
+	std::size_t mSize;
+	bool mReady{false};
+
+	std::size_t
+	readBytes(std::byte* dest, std::size_t) override
+	{
+		if (!mSize)
+			throw Input::Exception{std::make_error_code(std::errc::no_message_available)};
+		if (!std::exchange(mReady, false))
+			return 0;
+		dest[0] = static_cast<std::byte>(*mData++);
+		--mSize;
+		return 1;
+	}
+
+	std::error_code
+	waitReadable(unsigned) noexcept override
+	{
+		++waits;
+		mReady = true;
+		return {};
+	}
+
+public:
+
+	unsigned waits{0};
+
+	Sparse(char const* data, std::size_t size) noexcept
+			: mData{data}
+			, mSize{size}
+	{}
+
+};
+
+int main()
+{
+	Sparse source{"abcdef", 6};
+	Stream::BufferInput buffer(4);
+	source > buffer;
+
+	char dest[6];
+	buffer.read(dest, sizeof dest);
+	assert(!std::memcmp(dest, "abcdef", sizeof dest));
+	assert(source.waits == 6);
+
+	auto r{buffer.tryRead(dest, 1)};
+	assert(!r && r.error() == std::make_error_code(std::errc::no_message_available));
+
+	Stream::Backoff backoff{.spins = 1, .yields = 1, .minSleep = std::chrono::microseconds{1}, .maxSleep = std::chrono::microseconds{2}};
+	for (unsigned attempt{0}; attempt < 8; ++attempt)
+		backoff(attempt);
+
+	int pair[2];
+	assert(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) == 0);
+	assert(::dup2(pair[0], STDIN_FILENO) == STDIN_FILENO);
+	::close(pair[0]);
+
+	{ // a non-blocking descriptor is polled until the data arrives
+		assert(::fcntl(STDIN_FILENO, F_SETFL, ::fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK) == 0);
+		Stream::BufferInput stdIn(4);
+		Stream::StdIn > stdIn;
+		std::jthread writer{[&] {
+			std::this_thread::sleep_for(std::chrono::milliseconds{20});
+			assert(::write(pair[1], "ghij", 4) == 4);
+		}};
+		stdIn.read(dest, 4);
+		assert(!std::memcmp(dest, "ghij", 4));
+	}
+
+	{ // the timeout of a blocking descriptor is an error instead of a wait
+		assert(::fcntl(STDIN_FILENO, F_SETFL, ::fcntl(STDIN_FILENO, F_GETFL) & ~O_NONBLOCK) == 0);
+		::timeval const timeout{.tv_sec = 0, .tv_usec = 20'000};
+		assert(::setsockopt(STDIN_FILENO, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout) == 0);
+		Stream::BufferInput stdIn(4);
+		Stream::StdIn > stdIn;
+		auto r{stdIn.tryRead(dest, 1)};
+		assert(!r && r.error() == std::make_error_code(std::errc::resource_unavailable_try_again));
+	}
+	::close(pair[1]);
+
+	return 0;
+}
@@ -0,0 +1,43 @@
+#include <Stream/Chain.hpp>
+#include <Stream/Pipe.hpp>
+#include <Stream/Text.hpp>
+#include <cassert>
+
+using namespace Stream;
+
+int main()
+{
+	Chain<Pipe, Buffer, Text> text{std::tuple{}, std::tuple{64}, std::tuple{}};
+	static_assert(!std::is_same_v<decltype(text)::StageType<1>, Buffer>);
+	static_assert(!std::is_same_v<decltype(text)::Back, Text>);
+	static_assert(std::derived_from<decltype(text)::Back, Text>);
+
+	for (int i{0}; i < 100; ++i)
+		text.back() << i << '\n';
+	text.back() < nullptr;
+
+	for (int i{0}, j; i < 100; ++i) {
+		char c;
+		text.back() >> j >> c;
+		assert(i == j && c == '\n');
+	}
+
+	Chain<Pipe, Buffer> binary{std::tuple{}, std::tuple{16}};
+	for (std::uint64_t i{0}; i < 100; ++i)
+		binary << i;
+	binary.back() < nullptr;
+	for (std::uint64_t i{0}, j; i < 100; ++i) {
+		binary >> j;
+		assert(i == j);
+	}
+
+	Pipe pipe;
+	pipe | binary.back(); // relinked at runtime
+	binary << std::uint64_t{42};
+	binary.back() < nullptr;
+	std::uint64_t k;
+	binary >> k;
+	assert(k == 42);
+
+	return 0;
+}
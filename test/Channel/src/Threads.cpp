@@ -0,0 +1,66 @@
+#include <Stream/Buffer.hpp>
+#include <Stream/Channel.hpp>
+#include <Stream/ReadAhead.hpp>
+#include <Stream/Text.hpp>
+#include <Stream/WriteBehind.hpp>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <thread>
+
+int main()
+{
+	std::string data(1 << 20, '\0');
+	for (std::size_t i{0}; i < data.size(); ++i)
+		data[i] = static_cast<char>(i * 7 + i / 4093);
+
+	{ // a writer thread feeds a buffered reader through a ring much smaller than the data
+		Stream::Channel channel(1000);
+		assert(channel.getCapacity() == 1024);
+
+		std::jthread writer{[&] {
+			for (std::size_t offset{0}, chunk{1}; offset < data.size(); offset += chunk, chunk = chunk % 3001 + 17)
+				channel.write(data.data() + offset, std::min(chunk, data.size() - offset));
+			channel.closeOutput();
+		}};
+
+		Stream::BufferInput buffer(512);
+		channel > buffer;
+		std::string copy(data.size(), '\0');
+		for (std::size_t offset{0}, chunk{1}; offset < copy.size(); offset += chunk, chunk = chunk % 2003 + 5)
+			buffer.read(copy.data() + offset, std::min(chunk, copy.size() - offset));
+		assert(copy == data);
+
+		char c;
+		auto r{buffer.tryRead(&c, 1)};
+		assert(!r && r.error() == std::make_error_code(std::errc::no_message_available));
+	}
+
+	{ // the writer finds out when the reader is gone
+		Stream::Channel channel(16);
+		channel.write(data.data(), 16);
+		channel.closeInput();
+		auto r{channel.tryWrite(data.data(), 1)};
+		assert(!r && r.error() == std::make_error_code(std::errc::broken_pipe));
+	}
+
+	{ // a read-ahead thread waiting for an idle writer is interrupted on destruction
+		Stream::Channel channel(16);
+		channel.write("Line\n", 5);
+		Stream::ReadAheadInput ahead(64);
+		Stream::TextInput text;
+		channel > ahead > text;
+		assert(text.getLine() == "Line");
+		std::this_thread::sleep_for(std::chrono::milliseconds{20}); // let the thread go to sleep
+	}
+
+	{ // a write-behind thread waiting for an idle reader is interrupted on destruction
+		Stream::Channel channel(16);
+		Stream::WriteBehindOutput behind(16, 4);
+		channel < behind;
+		behind.write(data.data(), 40); // more than the ring takes
+		std::this_thread::sleep_for(std::chrono::milliseconds{20});
+	}
+
+	return 0;
+}
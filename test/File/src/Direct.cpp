@@ -0,0 +1,65 @@
+#include <Stream/Buffer.hpp>
+#include <Stream/File.hpp>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+int main()
+{
+	auto const name{(std::filesystem::temp_directory_path() / "Stream_File_Direct").string()};
+
+	std::string data(50'000, '\0');
+	for (std::size_t i{0}; i < data.size(); ++i)
+		data[i] = static_cast<char>(i * 31 + i / 97);
+
+	std::size_t blockSize;
+	{
+		Stream::File file(name, Stream::File::Mode::W, Stream::File::Caching::Direct);
+		blockSize = *file.getBlockSize();
+
+		Stream::BufferOutput output(1000);
+		output.setOutputPolicy({.alignment = blockSize});
+		assert(output.getOutputCapacity() == blockSize);
+		assert(reinterpret_cast<std::uintptr_t>(output.begin()) % blockSize == 0);
+		file < output;
+
+		for (std::size_t offset{0}; offset < data.size(); offset += 777)
+			output.write(data.data() + offset, std::min<std::size_t>(777, data.size() - offset));
+		output < nullptr; // the unaligned tail is written through the page cache
+		assert(output.getOutputCapacity() % blockSize == 0);
+	}
+	assert(std::filesystem::file_size(name) == data.size());
+
+	{
+		Stream::File file(name, Stream::File::Mode::R, Stream::File::Caching::Direct);
+		Stream::BufferInput input(blockSize);
+		input.setInputPolicy({.alignment = blockSize});
+		file > input;
+
+		std::string copy(data.size(), '\0');
+		for (std::size_t offset{0}; offset < copy.size(); offset += 1234) {
+			auto const size{std::min<std::size_t>(1234, copy.size() - offset)};
+			input.read(copy.data() + offset, size);
+		}
+		assert(copy == data);
+		assert(input.getInputCapacity() % blockSize == 0);
+	}
+
+	{ // an unaligned write to a direct file in append mode lands at the end as well
+		Stream::File file(name, Stream::File::Mode::AR, Stream::File::Caching::Direct);
+		file.write("xyz", 3);
+		file.write("uvw", 3);
+	}
+	assert(std::filesystem::file_size(name) == data.size() + 6);
+	{
+		Stream::File file(name, Stream::File::Mode::R);
+		std::string copy(data.size() + 6, '\0');
+		file.read(copy.data(), copy.size());
+		assert(copy == data + "xyzuvw");
+	}
+
+	std::filesystem::remove(name);
+	return 0;
+}
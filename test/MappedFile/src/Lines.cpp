@@ -0,0 +1,60 @@
+#include <Stream/MappedFile.hpp>
+#include <Stream/Text.hpp>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+int main()
+{
+	auto const name{(std::filesystem::temp_directory_path() / "Stream_MappedFile_Lines").string()};
+
+	std::string data;
+	for (int i{0}; i < 20'000; ++i)
+		data += "Line " + std::to_string(i) + (i % 3 ? "\n" : "\r\n");
+	std::ofstream{name, std::ios::binary} << data;
+
+	for (std::size_t windowSize : {std::size_t{0}, std::size_t{4096}, std::size_t{10'000}}) {
+		Stream::MappedFile file(name, windowSize);
+		assert(file.getFileSize() == static_cast<::off_t>(data.size()));
+		if (!windowSize) // the whole file is presented without reading
+			assert(file.getDataSize() == data.size());
+
+		Stream::TextInput text;
+		file > text;
+		for (int i{0}; i < 20'000; ++i)
+			assert(text.getLine() == "Line " + std::to_string(i));
+
+		try {
+			text.getLine();
+			assert(false);
+		} catch (Stream::Input::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::no_message_available)));
+		}
+	}
+
+	{ // a request larger than the window maps as much as needed
+		Stream::MappedFile file(name, 4096);
+		std::string copy(data.size(), '\0');
+		file.read(copy.data(), copy.size());
+		assert(copy == data);
+	}
+
+	std::ofstream{name, std::ios::binary | std::ios::trunc};
+	{
+		Stream::MappedFile file(name);
+		assert(!file.getDataSize());
+		std::byte b;
+		assert(!file.tryRead(&b, 1));
+	}
+
+	std::filesystem::remove(name);
+
+	try {
+		Stream::MappedFile file(name);
+		assert(false);
+	} catch (Stream::MappedFile::Exception const& exc) {
+		assert((exc.code() == std::make_error_code(std::errc::no_such_file_or_directory)));
+	}
+	return 0;
+}
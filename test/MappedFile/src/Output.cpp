@@ -0,0 +1,54 @@
+#include <Stream/MappedFile.hpp>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+int main()
+{
+	auto const name{(std::filesystem::temp_directory_path() / "Stream_MappedFile_Output").string()};
+
+	{
+		Stream::MappedFileOutput output(name, 1000);
+		assert(output.getSpaceSize() >= 1000);
+
+		for (std::uint32_t i{0}; i < 100'000; ++i) // grows the file and the mapping many times
+			output << i;
+		output << std::string(50'000, 'x'); // larger than the growth step
+		assert(output.getFileSize() == 100'000 * sizeof(std::uint32_t) + sizeof(std::size_t) + 50'000);
+
+		output < nullptr;
+		assert(std::filesystem::file_size(name) >= output.getFileSize()); // reserved, not trimmed yet
+
+		output.alloc(10);
+		std::memcpy(output.begin(), "0123456789", 10);
+		output.produced(10);
+	} // closing trims to the produced size
+
+	std::ifstream file{name, std::ios::binary};
+	std::string data{std::istreambuf_iterator<char>{file}, {}};
+	assert(data.size() == 100'000 * sizeof(std::uint32_t) + sizeof(std::size_t) + 50'000 + 10);
+	for (std::uint32_t i{0}; i < 100'000; ++i)
+		assert(*reinterpret_cast<std::uint32_t const*>(data.data() + i * sizeof(i)) == i);
+	assert(data.ends_with(std::string(50'000, 'x') + "0123456789"));
+
+	{
+		Stream::MappedFileOutput output(name);
+		output.close();
+		output.close();
+	}
+	assert(std::filesystem::is_empty(name));
+
+	{ // growing beyond the maxSize of the policy fails as a buffer does
+		Stream::MappedFileOutput output(name, 4096);
+		output.setOutputPolicy({.maxSize = 8192});
+		auto r{output.tryAlloc(10'000)};
+		assert(!r && r.error() == make_error_code(Stream::Buffer::Exception::Code::BadAllocation));
+	}
+
+	std::filesystem::remove(name);
+	return 0;
+}
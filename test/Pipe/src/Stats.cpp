@@ -0,0 +1,46 @@
+#include <Stream/Pipe.hpp>
+#include <Stream/Text.hpp>
+#include <cassert>
+#include <string_view>
+
+int main()
+{
+	Stream::Pipe pipe;
+	Stream::BufferInput buffer(64);
+	pipe > buffer;
+
+	std::uint64_t const out[]{1, 2, 3, 4};
+	pipe.write(out, sizeof out);
+	std::uint64_t in[4];
+	buffer.read(in, sizeof in);
+	pipe << nullptr;
+
+	auto const& stats{pipe.getInputProbe().getStats()};
+	if constexpr (Stream::Instrumented) {
+		assert(stats.bytes == sizeof in);
+		assert(stats.calls >= 1 && stats.syscalls >= stats.calls);
+		assert(stats.latency.getCount() == stats.calls);
+		assert(pipe.getOutputProbe().getStats().bytes == sizeof out);
+		assert(pipe.getOutputProbe().getStats().flushLatency.getCount() == 1);
+	} else {
+		assert(stats.calls == 0 && stats.bytes == 0);
+	}
+
+	char report[512];
+	Stream::BufferOutput sink(report, sizeof report);
+	Stream::TextOutput text;
+	sink < text;
+	text << stats;
+	std::string_view const line{report, sizeof report - sink.getSpaceSize()};
+	assert(line.starts_with("calls="));
+	assert(line.find(" latency{count=") != std::string_view::npos);
+
+	Stream::Histogram h;
+	h.record(std::chrono::nanoseconds{100});
+	h.record(std::chrono::nanoseconds{1000});
+	assert(h.getCount() == 2);
+	assert(h.getPercentile(0.5) == std::chrono::nanoseconds{128});
+	assert(h.getPercentile(1) == std::chrono::nanoseconds{1024});
+
+	return 0;
+}
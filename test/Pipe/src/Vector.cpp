@@ -0,0 +1,54 @@
+#include <Stream/Pipe.hpp>
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <vector>
+
+int main()
+{
+	Stream::Pipe pipe;
+
+	std::string const str{"payload"};
+	pipe << str << "header";
+
+	std::uint64_t size;
+	char payload[7];
+	::iovec const iov[]{
+		{&size, sizeof size},
+		{nullptr, 0},
+		{payload, sizeof payload}
+	};
+	pipe.read(iov);
+	assert(size == str.size());
+	assert(!std::memcmp(payload, str.data(), size));
+
+	std::string header;
+	pipe >> header;
+	assert(header == "header");
+
+	char const a[]{"abc"};
+	char const b[]{"defgh"};
+	::iovec const out[]{
+		{const_cast<char*>(a), 3},
+		{nullptr, 0},
+		{const_cast<char*>(b), 5}
+	};
+	pipe.write(out);
+	char joined[8];
+	pipe.read(joined, sizeof joined);
+	assert(!std::memcmp(joined, "abcdefgh", 8));
+
+	// more areas than a single writev() takes
+	std::vector<char> bytes(IOV_MAX + 100);
+	std::vector<::iovec> many;
+	for (std::size_t i{0}; i < bytes.size(); ++i) {
+		bytes[i] = static_cast<char>(i);
+		many.push_back({&bytes[i], 1});
+	}
+	pipe.write(many);
+	std::vector<char> back(bytes.size());
+	pipe.read(back.data(), back.size());
+	assert(back == bytes);
+
+	return 0;
+}
@@ -0,0 +1,134 @@
+#include <Stream/ReadAhead.hpp>
+#include <Stream/Text.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <poll.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * Source handing out the data in chunks of varying size, then failing with an error
+ */
+class Chunks : public Stream::Input {
+	std::string mData;
+	std::size_t mPosition{0};
+	std::size_t mCount{0};
+	std::error_code mError;
+
+	std::size_t
+	readBytes(std::byte* dest, std::size_t size) override
+	{
+		if (mPosition == mData.size())
+			throw Exception{mError};
+		size = std::min({size, mData.size() - mPosition, std::size_t{++mCount % 37 + 1}});
+		std::memcpy(dest, mData.data() + mPosition, size);
+		mPosition += size;
+		return size;
+	}
+
+public:
+
+	Chunks(std::string data, std::error_code error)
+			: mData{std::move(data)}
+			, mError{error}
+	{}
+
+};//class Chunks
+
+/**
+ * Source handing out a line, then waiting on a descriptor that never becomes readable
+ */
+class Idle : public Stream::Input {
+	int mPipe[2];
+	bool mRead{false};
+
+	std::size_t
+	readBytes(std::byte* dest, std::size_t) override
+	{
+		if (std::exchange(mRead, true))
+			return 0;
+		std::memcpy(dest, "Line\n", 5);
+		return 5;
+	}
+
+	std::error_code
+	waitReadable(unsigned) noexcept override
+	{
+		waiting = true;
+		return Stream::Poll(mPipe[0], POLLIN);
+	}
+
+public:
+
+	std::atomic<bool> waiting{false};
+
+	Idle() noexcept
+	{ assert(::pipe(mPipe) == 0); }
+
+	~Idle()
+	{
+		::close(mPipe[0]);
+		::close(mPipe[1]);
+	}
+
+};//class Idle
+
+int main()
+{
+	std::string data;
+	for (int i{0}; i < 10'000; ++i)
+		data += "Line " + std::to_string(i) + "\n";
+
+	for (std::size_t depth : {2, 3, 8}) {
+		Chunks chunks{data, std::make_error_code(std::errc::no_message_available)};
+		Stream::ReadAheadInput ahead(16, depth);
+		assert(ahead.getDepth() == depth);
+		Stream::TextInput text;
+		chunks > ahead > text;
+
+		for (int i{0}; i < 10'000; ++i) // most lines cross the end of a block
+			assert(text.getLine() == "Line " + std::to_string(i));
+		try {
+			text.getLine();
+			assert(false);
+		} catch (Stream::Input::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::no_message_available)));
+		}
+	}
+
+	{ // the error of the source is seen after the data before it
+		Chunks chunks{data, std::make_error_code(std::errc::io_error)};
+		Stream::ReadAheadInput ahead(1000);
+		chunks > ahead;
+
+		std::string copy(data.size(), '\0');
+		ahead.read(copy.data(), copy.size());
+		assert(copy == data);
+		std::byte b;
+		auto r{ahead.tryRead(&b, 1)};
+		assert(!r && r.error() == std::make_error_code(std::errc::io_error));
+	}
+
+	{ // destroyed while reading ahead
+		Chunks chunks{data, std::make_error_code(std::errc::no_message_available)};
+		Stream::ReadAheadInput ahead(64, 4);
+		Stream::TextInput text;
+		chunks > ahead > text;
+		assert(text.getLine() == "Line 0");
+	}
+
+	{ // destroyed while the thread waits for the source
+		Idle idle;
+		Stream::ReadAheadInput ahead(64);
+		Stream::TextInput text;
+		idle > ahead > text;
+		assert(text.getLine() == "Line");
+		while (!idle.waiting)
+			std::this_thread::yield();
+	}
+	return 0;
+}
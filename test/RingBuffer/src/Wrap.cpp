@@ -0,0 +1,55 @@
+#include <Stream/RingBuffer.hpp>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+int main()
+{
+	auto const pageSize{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+
+	std::string data(10 * pageSize, '\0');
+	for (std::size_t i{0}; i < data.size(); ++i)
+		data[i] = static_cast<char>(i * 13 + i / 251);
+
+	{ // records straddling the wrap-around stay contiguous
+		Stream::BufferInput source(data.data(), data.size());
+		Stream::RingBufferInput ring(1);
+		source > ring;
+		assert(ring.getInputCapacity() == pageSize);
+
+		std::size_t const record{pageSize / 3 + 7};
+		std::size_t offset{0};
+		for (; offset + record <= data.size(); offset += record) {
+			assert(ring.provide(record) == record);
+			assert(!std::memcmp(ring.begin(), data.data() + offset, record));
+			ring.consumed(record);
+		}
+		assert(ring.getInputCapacity() == pageSize);
+
+		std::string rest(data.size() - offset, '\0');
+		ring.read(rest.data(), rest.size());
+		assert(!std::memcmp(rest.data(), data.data() + offset, rest.size()));
+		auto r{ring.tryRead(rest.data(), 1)};
+		assert(!r && r.error() == std::make_error_code(std::errc::no_message_available));
+	}
+
+	{ // a request larger than the capacity grows the ring
+		Stream::BufferInput source(data.data(), data.size());
+		Stream::RingBufferInput ring(pageSize);
+		source > ring;
+		ring.provide(100);
+		ring.consumed(50);
+		assert(ring.provide(3 * pageSize) == 3 * pageSize);
+		assert(ring.getInputCapacity() >= 3 * pageSize);
+		assert(!std::memcmp(ring.begin(), data.data() + 50, 3 * pageSize));
+
+		Stream::RingBufferInput moved{std::move(ring)};
+		moved.consumed(3 * pageSize);
+		char c;
+		moved >> c;
+		assert(c == data[50 + 3 * pageSize]);
+	}
+
+	return 0;
+}
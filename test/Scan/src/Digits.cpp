@@ -0,0 +1,77 @@
+#include <Stream/Scan.hpp>
+#include <Stream/Text.hpp>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+
+static bool
+IsDigit(char c, unsigned base)
+{
+	for (unsigned v{0}; v < base; ++v)
+		if (c == "0123456789abcdefghijklmnopqrstuvwxyz"[v] || c == "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"[v])
+			return true;
+	return false;
+}
+
+/**
+ * Text input exposing the digit runs
+ */
+struct Digits : Stream::TextInput {
+	using TextInput::provideDigits10;
+	using TextInput::provideDigits36;
+};
+
+int main()
+{
+	for (unsigned base{2}; base <= 36; ++base)
+		for (int c{-128}; c < 128; ++c) { // every character at every position of a run
+			std::string text(100, '0');
+			for (std::size_t at{0}; at < 70; at += 13) {
+				text[at] = static_cast<char>(c);
+				auto const* p{Stream::SkipDigits(text.data(), text.data() + text.size(), base)};
+				assert(p == text.data() + (IsDigit(static_cast<char>(c), base) ? text.size() : at));
+				text[at] = '0';
+			}
+		}
+
+	{ // numbers split across refills of a small buffer
+		std::string const text{"18446744073709551615 -9223372036854775808 ffffFFFFffffFFFF 7f 0"};
+		Stream::BufferInput source(text.data(), text.size());
+		Stream::BufferInput buffer(4);
+		Stream::TextInput str;
+		source > buffer > str;
+
+		std::uint64_t u;
+		std::int64_t i;
+		char space;
+		str >> u >> space;
+		assert(u == 18446744073709551615u);
+		str >> i >> space;
+		assert(i == std::numeric_limits<std::int64_t>::min());
+		str.fromChars(u, 16) >> space;
+		assert(u == 0xffffffffffffffff);
+		str.fromChars(u, 16) >> space;
+		assert(u == 0x7f);
+		str >> u;
+		assert(u == 0);
+	}
+
+	for (auto const& [text, base, digits] : { // a run that exceeds the limit by a single digit is out of range as well
+		std::tuple{"123", 10u, 3}, std::tuple{"123 ", 10u, 3}, std::tuple{"1234", 10u, -1}, std::tuple{"12345", 10u, -1},
+		std::tuple{"abcd", 10u, 0}, std::tuple{"abc", 16u, 3}, std::tuple{"abcd", 16u, -1}
+	}) {
+		Stream::BufferInput buffer(text, std::strlen(text));
+		Digits str;
+		buffer > str;
+		try {
+			auto const n{base == 10 ? str.provideDigits10(0, 3) : str.provideDigits36(0, 3)};
+			assert(n == static_cast<std::size_t>(digits));
+		} catch (Stream::Input::Exception const& exc) {
+			assert(digits == -1);
+			assert((exc.code() == std::make_error_code(std::errc::result_out_of_range)));
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,37 @@
+#include <Stream/Scan.hpp>
+#include <Stream/Text.hpp>
+#include <cassert>
+#include <string>
+
+int main()
+{
+	std::string text(200, 'a');
+	for (std::size_t offset{0}; offset < 40; ++offset) // every alignment of the start
+		for (std::size_t size{0}; offset + size <= text.size(); ++size) {
+			auto const* beg{text.data() + offset};
+			assert(Stream::FindByte(beg, beg + size, '\n') == beg + size);
+			for (std::size_t at : {std::size_t{0}, size / 2, size - 1})
+				if (at < size) {
+					text[offset + size - 1] = '\n'; // a later one does not matter
+					text[offset + at] = '\n';
+					assert(Stream::FindByte(beg, beg + size, '\n') == beg + at);
+					text.assign(200, 'a');
+				}
+		}
+
+	{ // the limit still applies to the length before the delimiter
+		auto const line{std::string(100, 'x') + "\r\n" + std::string(101, 'y') + "\n"};
+		Stream::BufferInput buffer(line.data(), line.size());
+		Stream::TextInput str;
+		buffer > str;
+		assert(str.getLine(101) == std::string(100, 'x'));
+		try {
+			str.getLine(100);
+			assert(false);
+		} catch (Stream::Input::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::result_out_of_range)));
+		}
+		assert(str.getLine(101) == std::string(101, 'y'));
+	}
+	return 0;
+}
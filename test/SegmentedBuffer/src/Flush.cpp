@@ -0,0 +1,73 @@
+#include <Stream/SegmentedBuffer.hpp>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+/**
+ * In-memory sink that counts the vectored writes
+ */
+class Memory : public Stream::Output {
+
+	std::size_t
+	writeBytes(std::byte const* src, std::size_t size) override
+	{
+		data.append(reinterpret_cast<char const*>(src), size);
+		return size;
+	}
+
+	std::size_t
+	writeVector(std::span<::iovec const> iov) override
+	{
+		++vectors;
+		std::size_t total{0};
+		for (auto const& v : iov) {
+			data.append(static_cast<char const*>(v.iov_base), v.iov_len);
+			total += v.iov_len;
+		}
+		return total;
+	}
+
+public:
+
+	std::string data;
+	unsigned vectors{0};
+
+};
+
+int main()
+{
+	std::string expected;
+	for (int i{0}; i < 100; ++i)
+		expected += "segment " + std::to_string(i) + ';';
+
+	Memory sink;
+	Stream::SegmentedBufferOutput output(64);
+	sink < output;
+
+	output.write(expected.data(), expected.size()); // grows by appending segments
+	assert(output.getSegmentCount() == (expected.size() + 63) / 64);
+	assert(output.getDataSize() == expected.size());
+	assert(sink.data.empty());
+
+	output << nullptr;
+	assert(sink.data == expected);
+	assert(sink.vectors == 1);
+	assert(output.getDataSize() == 0);
+
+	auto const segments{output.getSegmentCount()};
+	sink.data.clear();
+
+	// produce in place, a large allocation gets a segment of its own
+	assert(output.allocSome(10) == 10);
+	std::memcpy(output.begin(), "0123456789", 10);
+	output.produced(10);
+	assert(output.alloc(100) == 100 && output.getSpaceSize() == 100);
+	std::memset(output.begin(), 'x', 100);
+	output.produced(100);
+	output.write("end", 3);
+	output << nullptr;
+	assert(sink.data == "0123456789" + std::string(100, 'x') + "end");
+	assert(output.getSegmentCount() == segments);
+
+	return 0;
+}
@@ -0,0 +1,165 @@
+#include <Stream/Tee.hpp>
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <utility>
+
+/**
+ * In-memory sink, a slow one accepts a single byte per write and signals for retry in between
+ * @details	Once the data reaches failAt, the next write throws a single time.
+ */
+class Memory : public Stream::Output {
+	bool mSlow;
+	bool mReady{false};
+
+	std::size_t
+	writeBytes(std::byte const* src, std::size_t size) override
+	{
+		if (mSlow) {
+			if (!std::exchange(mReady, false))
+				return 0;
+			size = 1;
+		}
+		if (data.size() == failAt) {
+			failAt = std::string::npos;
+			throw Output::Exception{std::make_error_code(std::errc::broken_pipe)};
+		}
+		size = std::min(size, failAt - data.size());
+		data.append(reinterpret_cast<char const*>(src), size);
+		return size;
+	}
+
+	std::error_code
+	waitWritable(unsigned) noexcept override
+	{
+		++waits;
+		mReady = true;
+		return {};
+	}
+
+	void
+	flush() override
+	{ ++flushes; }
+
+public:
+
+	std::string data;
+	unsigned waits{0};
+	unsigned flushes{0};
+	std::size_t failAt{std::string::npos};
+
+	explicit
+	Memory(bool slow = false) noexcept
+			: mSlow{slow}
+	{}
+
+};
+
+int main()
+{
+	{ // every sink gets everything, vectored writes included
+		Memory first, second;
+		Stream::TeeOutput tee;
+		first < tee;
+		second < tee;
+		assert(tee.getSinkCount() == 2);
+
+		tee << std::string{"abc"};
+		tee.write("de", 2);
+		assert(first.data == second.data);
+		assert(first.data.size() == sizeof(std::uint64_t) + 5 && first.data.ends_with("abcde"));
+
+		tee < nullptr;
+		assert(first.flushes == 1 && second.flushes == 1);
+
+		nullptr < tee;
+		assert(tee.getSinkCount() == 0);
+		tee.write("f", 1);
+		assert(first.data.ends_with("abcde"));
+	}
+
+	{ // block waits for the slow sink
+		Memory slow{true};
+		Stream::TeeOutput tee{Stream::TeeOutput::Policy::Block};
+		slow < tee;
+		tee.write("abcd", 4);
+		assert(slow.data == "abcd");
+		assert(slow.waits == 4);
+	}
+
+	{ // buffer keeps the rest until the limit is exceeded or the tee is flushed
+		Memory slow{true}, fast;
+		Stream::TeeOutput tee{Stream::TeeOutput::Policy::Buffer, 4};
+		slow < tee;
+		fast < tee;
+
+		tee.write("abcd", 4);
+		assert(slow.data.empty() && slow.waits == 0);
+		assert(tee.getBacklogSize(0) == 4 && tee.getBacklogSize(1) == 0);
+		assert(fast.data == "abcd");
+
+		tee.write("efg", 3); // backlog of 7 goes down to the limit
+		assert(slow.data == "abc");
+		assert(tee.getBacklogSize(0) == 4);
+
+		tee << nullptr;
+		assert(slow.data == "abcdefg" && fast.data == "abcdefg");
+		assert(tee.getBacklogSize(0) == 0);
+		assert(slow.flushes == 1);
+	}
+
+	{ // block resumes a write that a sink threw from without writing it again to the others
+		Memory first, second, third;
+		second.failAt = 2;
+		third.failAt = 0;
+		Stream::TeeOutput tee{Stream::TeeOutput::Policy::Block};
+		first < tee;
+		second < tee;
+		third < tee;
+		std::string const ab{"ab"}, cd{"cd"};
+		::iovec const iov[]{{const_cast<char*>(ab.data()), ab.size()}, {const_cast<char*>(cd.data()), cd.size()}};
+		for (int failures{0}; failures < 2; ++failures)
+			try {
+				tee.write(iov);
+				assert(false);
+			} catch (Stream::Output::Exception const& exc) {
+				assert((exc.code() == std::make_error_code(std::errc::broken_pipe)));
+			}
+		assert(first.data == "abcd" && second.data == "abcd" && third.data.empty());
+		tee.write(iov);
+		assert(first.data == "abcd" && second.data == "abcd" && third.data == "abcd");
+		tee.write(iov);
+		assert(first.data == "abcdabcd" && second.data == "abcdabcd" && third.data == "abcdabcd");
+	}
+
+	{ // a write of other data after a failure is not mistaken for a retry
+		Memory first, second;
+		second.failAt = 1;
+		Stream::TeeOutput tee{Stream::TeeOutput::Policy::Block};
+		first < tee;
+		second < tee;
+		std::string const dropped{"abcd"}, next{"efgh"};
+		try {
+			tee.write(dropped.data(), dropped.size());
+			assert(false);
+		} catch (Stream::Output::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::broken_pipe)));
+		}
+		assert(first.data == "abcd" && second.data == "a");
+		tee.write(next.data(), next.size());
+		assert(first.data == "abcdefgh" && second.data == "aefgh");
+	}
+
+	{ // buffer writes the backlogs on destruction
+		Memory slow{true};
+		{
+			Stream::TeeOutput tee{Stream::TeeOutput::Policy::Buffer, 4};
+			slow < tee;
+			tee.write("abcd", 4);
+			assert(slow.data.empty());
+		}
+		assert(slow.data == "abcd");
+	}
+
+	return 0;
+}
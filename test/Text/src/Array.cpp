@@ -0,0 +1,113 @@
+#include <Stream/Text.hpp>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <vector>
+
+/**
+ * Write @p values with writeArray(), then read them back with parseArray() through buffers of various sizes
+ */
+template <typename T>
+void
+testArray(std::vector<T> const& values, char sep)
+{
+	std::vector<char> storage(64 * values.size() + 64);
+	Stream::BufferOutput sink(storage.data(), storage.size());
+	Stream::BufferOutput buffer(64);
+	Stream::TextOutput out;
+	sink < buffer < out;
+	out.writeArray(std::span{values}, sep);
+	out << '\n';
+	buffer << nullptr;
+	std::string_view const text{storage.data(), storage.size() - sink.getSpaceSize()};
+	assert(text.back() == '\n' && std::count(text.begin(), text.end(), sep) == static_cast<std::ptrdiff_t>(values.size() - 1));
+
+	for (std::size_t bufferSize : {8, 100, 1 << 20}) {
+		Stream::BufferInput source(text.data(), text.size());
+		Stream::BufferInput buffer(bufferSize);
+		Stream::TextInput in;
+		source > buffer > in;
+
+		std::vector<T> copy(values.size());
+		in.parseArray(std::span{copy}, sep);
+		assert(copy == values);
+		assert(in.getLine().empty());
+	}
+}
+
+int main()
+{
+	std::mt19937_64 gen{1};
+	std::vector<std::int64_t> integers(10'000);
+	for (auto& i : integers)
+		i = static_cast<std::int64_t>(gen()) >> (gen() % 64);
+	integers.front() = std::numeric_limits<std::int64_t>::min();
+	integers.back() = std::numeric_limits<std::int64_t>::max();
+	testArray(integers, ',');
+	testArray(integers, ' ');
+
+	std::vector<std::uint8_t> bytes(1000);
+	for (auto& b : bytes)
+		b = static_cast<std::uint8_t>(gen());
+	testArray(bytes, ';');
+
+	std::vector<double> doubles(10'000);
+	std::uniform_real_distribution<double> real{-1e6, 1e6};
+	for (auto& d : doubles)
+		d = real(gen) * std::pow(10.0, static_cast<int>(gen() % 40) - 20); // with exponents to cross the refills
+	testArray(doubles, ',');
+
+	{ // a buffer capped below the size of a full batch takes smaller ones
+		std::vector<char> storage(64 * integers.size());
+		Stream::BufferOutput sink(storage.data(), storage.size());
+		Stream::BufferOutput buffer(64);
+		buffer.setOutputPolicy({.maxSize = 1000});
+		Stream::TextOutput out;
+		sink < buffer < out;
+		out.writeArray(std::span<std::int64_t const>{integers}, ',');
+		buffer << nullptr;
+
+		Stream::BufferInput source(storage.data(), storage.size() - sink.getSpaceSize());
+		Stream::TextInput in;
+		source > in;
+		std::vector<std::int64_t> copy(integers.size());
+		in.parseArray(std::span{copy}, ',');
+		assert(copy == integers);
+	}
+
+	for (auto const& [text, bufferSize] : { // a run of any whitespace separates when the separator is whitespace
+		std::pair{"1  2\n3 \t 4", 1 << 20}, std::pair{"1  2\n3 \t 4", 2}, std::pair{"1      2\n3 \t      4", 4}
+	}) {
+		Stream::BufferInput source(text, std::strlen(text));
+		Stream::BufferInput buffer(bufferSize);
+		Stream::TextInput in;
+		source > buffer > in;
+		std::array<std::int64_t, 4> values;
+		in.parseArray(std::span<std::int64_t>{values}, ' ');
+		assert((values == std::array<std::int64_t, 4>{1, 2, 3, 4}));
+	}
+
+	for (auto const& [text, code] : {
+		std::pair{"1,2;3\n", std::errc::invalid_argument},
+		std::pair{"1,2,x\n", std::errc::invalid_argument},
+		std::pair{"1,2,99999999999999999999\n", std::errc::result_out_of_range},
+		std::pair{"1,2", std::errc::no_message_available},
+	}) {
+		Stream::BufferInput buffer(text, std::strlen(text));
+		Stream::TextInput in;
+		buffer > in;
+		std::array<std::int64_t, 3> values;
+		try {
+			in.parseArray(std::span<std::int64_t>{values});
+			assert(false);
+		} catch (Stream::Input::Exception const& exc) {
+			assert(exc.code() == std::make_error_code(code));
+		}
+	}
+	return 0;
+}
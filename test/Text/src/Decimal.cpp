@@ -0,0 +1,70 @@
+#include <Stream/Text.hpp>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Check that the decimal parser agrees with std::from_chars() on @p text, appending a terminator or not
+ */
+template <typename I>
+static void
+Compare(std::string const& text)
+{
+	for (auto const& s : {text, text + " ", text + "x"}) {
+		I expected{42}, actual{42};
+		auto const e{std::from_chars(s.data(), s.data() + s.size(), expected)};
+		auto const a{Stream::detail::fromChars10(s.data(), s.data() + s.size(), actual)};
+		assert(a.ptr == e.ptr && a.ec == e.ec && actual == expected);
+	}
+}
+
+template <typename... I>
+static void
+CompareAll(std::string const& text)
+{ (Compare<I>(text), ...); }
+
+int main()
+{
+	std::vector<std::string> texts{
+		"", "-", "+1", " 1", "0", "-0", "00000000000000000000000000000001", "12345678", "-12345678", "1234567x9",
+		"127", "128", "-128", "-129", "255", "256", "32767", "32768", "-32768", "-32769", "65535", "65536",
+		"2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+		"9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+		"18446744073709551615", "18446744073709551616", "99999999999999999999", "184467440737095516150",
+		"123456789012345678901234567890",
+	};
+	std::mt19937_64 gen{1};
+	for (int n{0}; n < 20'000; ++n) {
+		std::string s{gen() % 4 ? "" : "-"};
+		for (auto length{gen() % 24}; length; --length)
+			s += static_cast<char>('0' + gen() % (n % 7 ? 10 : 11)); // sometimes a ':' ends the digits
+		texts.push_back(s);
+	}
+
+	for (auto const& text : texts)
+		CompareAll<short, unsigned short, int, unsigned, long, unsigned long, long long, unsigned long long, std::int8_t, std::uint8_t>(text);
+
+	{ // through the stream
+		auto const sv{"-9223372036854775808 18446744073709551615 00000000000000000042 18446744073709551616"};
+		Stream::BufferInput buffer(sv, std::strlen(sv));
+		Stream::TextInput str;
+		buffer > str;
+		std::int64_t i;
+		std::uint64_t u;
+		char space;
+		str >> i >> space >> u >> space;
+		assert(i == std::numeric_limits<std::int64_t>::min() && u == std::numeric_limits<std::uint64_t>::max());
+		str >> u >> space;
+		assert(u == 42);
+		try {
+			str >> u;
+			assert(false);
+		} catch (Stream::Input::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::result_out_of_range)));
+		}
+	}
+	return 0;
+}
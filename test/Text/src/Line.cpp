@@ -29,6 +29,20 @@ int main()
 		assert((exc.code() == std::make_error_code(std::errc::no_message_available)));
 	}
 
+	for (auto const& [text, line] : { // a line that exceeds the limit by a single character is out of range as well
+		std::pair{"abc"sv, "abc"sv}, std::pair{"abc\n"sv, "abc"sv}, std::pair{"abcd"sv, ""sv}, std::pair{"abcd\n"sv, ""sv}
+	}) {
+		Stream::BufferInput buffer(text.data(), text.size());
+		Stream::TextInput str;
+		buffer > str;
+		try {
+			assert(str.getLine(3) == line);
+		} catch (Stream::Input::Exception const& exc) {
+			assert(line.empty());
+			assert((exc.code() == std::make_error_code(std::errc::result_out_of_range)));
+		}
+	}
+
 	return 0;
 }
 
@@ -0,0 +1,51 @@
+#include <Stream/Text.hpp>
+#include <array>
+#include <cassert>
+#include <string>
+
+int main()
+{
+	std::string data;
+	for (int i{0}; i < 1000; ++i)
+		data += "Line " + std::to_string(i) + (i % 2 ? "\n" : "\r\n");
+	data += "Last";
+
+	for (std::size_t bufferSize : {16, 100, 100'000}) {
+		Stream::BufferInput source(data.data(), data.size());
+		Stream::BufferInput buffer(bufferSize);
+		Stream::TextInput str;
+		source > buffer > str;
+
+		std::array<std::string_view, 64> lines;
+		int count{0};
+		std::size_t batches{0};
+		while (auto n{str.getLines(lines)}) {
+			assert(n <= lines.size());
+			for (std::size_t i{0}; i < n; ++i, ++count)
+				assert(lines[i] == (count < 1000 ? "Line " + std::to_string(count) : "Last"));
+			++batches;
+		}
+		assert(count == 1001);
+		assert(bufferSize != 16 || batches > 900); // a small buffer holds a single line at a time
+		assert(bufferSize < 100'000 || batches == 17); // otherwise the batches are full, but the unterminated last line waits for a refill
+		assert(!str.getLines(lines));
+	}
+
+	{ // the line over the limit is left for the next call
+		auto const sv{"ab\nabcd\nabc\n"};
+		Stream::BufferInput buffer(sv, 12);
+		Stream::TextInput str;
+		buffer > str;
+
+		std::array<std::string_view, 4> lines;
+		assert(str.getLines(lines, 3) == 1 && lines[0] == "ab");
+		try {
+			str.getLines(lines, 3);
+			assert(false);
+		} catch (Stream::Input::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::result_out_of_range)));
+		}
+		assert(str.getLines(lines, 4) == 2 && lines[0] == "abcd" && lines[1] == "abc");
+	}
+	return 0;
+}
@@ -0,0 +1,59 @@
+#include <Stream/Text.hpp>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+
+/**
+ * Memory resource that overwrites the memory it takes back, so that reading it afterwards is noticed
+ */
+class Poisoning : public std::pmr::memory_resource {
+
+	void*
+	do_allocate(std::size_t bytes, std::size_t alignment) override
+	{ return std::pmr::new_delete_resource()->allocate(bytes, alignment); }
+
+	void
+	do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+		std::memset(p, '#', bytes);
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+
+	bool
+	do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+	{ return this == &other; }
+
+};
+
+int main()
+{
+	Poisoning resource;
+	std::string const data{"hello\nworld\r\nbye "};
+
+	{ // the views of a drained buffer stay valid until the next read
+		Stream::BufferInput source(data.data(), data.size());
+		Stream::BufferInput buffer(64, &resource);
+		buffer.setInputPolicy({.releaseEmpty = true});
+		Stream::TextInput str;
+		source > buffer > str;
+
+		std::array<std::string_view, 4> lines;
+		assert(str.getLines(lines) == 2 && lines[0] == "hello" && lines[1] == "world");
+		assert(str.getUntil(' ') == "bye");
+	}
+
+	{
+		Stream::BufferInput source(data.data(), 6);
+		Stream::BufferInput buffer(64, &resource);
+		buffer.setInputPolicy({.releaseEmpty = true});
+		Stream::TextInput str;
+		source > buffer > str;
+
+		auto const line{str.getLine()};
+		assert(buffer.getDataSize() == 0);
+		assert(line == "hello");
+	}
+	return 0;
+}
@@ -0,0 +1,52 @@
+#include <Stream/Buffer.hpp>
+#include <Stream/File.hpp>
+#include <Stream/Pipe.hpp>
+#include <Stream/Transfer.hpp>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+int main()
+{
+	auto const dir{std::filesystem::temp_directory_path()};
+	auto const a{(dir / "Stream_Transfer_A").string()};
+	auto const b{(dir / "Stream_Transfer_B").string()};
+
+	std::string data(100'000, '\0');
+	for (std::size_t i{0}; i < data.size(); ++i)
+		data[i] = static_cast<char>(i * 7);
+
+	{ // user space copy from memory to file
+		Stream::BufferInput memory(data.data(), data.size());
+		Stream::File file(a, Stream::File::Mode::W);
+		assert(Stream::Transfer(memory, file, data.size()) == data.size());
+	}
+
+	{ // copy_file_range, stops at the end of the source
+		Stream::File source(a, Stream::File::Mode::R);
+		Stream::File sink(b, Stream::File::Mode::W);
+		assert(Stream::Transfer(source, sink, data.size() + 10) == data.size());
+	}
+	assert(std::filesystem::file_size(b) == data.size());
+
+	{ // splice from file to pipe and from pipe to file
+		Stream::Pipe pipe;
+		Stream::File source(b, Stream::File::Mode::R);
+		Stream::File sink(a, Stream::File::Mode::W);
+		std::jthread writer{[&] { assert(Stream::Transfer(source, pipe, data.size()) == data.size()); }};
+		assert(Stream::Transfer(pipe, sink, data.size()) == data.size());
+	}
+
+	{ // user space copy from file to memory
+		std::string copy(data.size(), '\0');
+		Stream::File source(a, Stream::File::Mode::R);
+		Stream::BufferOutput memory(copy.data(), copy.size());
+		assert(Stream::Transfer(source, memory, data.size()) == data.size());
+		assert(copy == data);
+	}
+
+	std::filesystem::remove(a);
+	std::filesystem::remove(b);
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include <Stream/File.hpp>
+#include <Stream/Socket.hpp>
+#include <Stream/Transfer.hpp>
+#include <cassert>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+int main()
+{
+	auto const dir{std::filesystem::temp_directory_path()};
+	auto const a{(dir / "Stream_Transfer_Socket_A").string()};
+	auto const b{(dir / "Stream_Transfer_Socket_B").string()};
+
+	std::string data(100'000, '\0');
+	for (std::size_t i{0}; i < data.size(); ++i)
+		data[i] = static_cast<char>(i * 13);
+	{
+		Stream::File file(a, Stream::File::Mode::W);
+		file.write(data.data(), data.size());
+	}
+
+	Stream::Socket server(Stream::Socket::Address::Inet{"127.0.0.1", 0}, 1);
+	auto const port{server.getPort()};
+	assert(port && *port);
+	Stream::Socket client(Stream::Socket::Address::Inet{"127.0.0.1", *port});
+	auto connection{server.accept()};
+	assert(connection);
+
+	{ // sendfile from file to socket, splice through a pipe from socket to file
+		Stream::File source(a, Stream::File::Mode::R);
+		Stream::File sink(b, Stream::File::Mode::W);
+		std::jthread writer{[&] { assert(Stream::Transfer(source, client, data.size()) == data.size()); }};
+		assert(Stream::Transfer(*connection, sink, data.size()) == data.size());
+	}
+	{
+		Stream::File file(b, Stream::File::Mode::R);
+		std::string copy(data.size(), '\0');
+		file.read(copy.data(), copy.size());
+		assert(copy == data);
+	}
+
+	{ // a sink that refuses the data already taken from the socket is an output error
+		Stream::File sink(b, Stream::File::Mode::A);
+		client.write(data.data(), 1000);
+		try {
+			Stream::Transfer(*connection, sink, 1000);
+			assert(false);
+		} catch (Stream::Output::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::invalid_argument)));
+		}
+	}
+
+	std::filesystem::remove(a);
+	std::filesystem::remove(b);
+	return 0;
+}
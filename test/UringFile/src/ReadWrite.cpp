@@ -0,0 +1,74 @@
+#include <Stream/Buffer.hpp>
+#include <Stream/UringFile.hpp>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+
+int main()
+{
+	auto const path{(std::filesystem::temp_directory_path() / "Stream_UringFile_ReadWrite").string()};
+	constexpr std::uint32_t count{100'000};
+
+	{
+		Stream::UringFile file(path, Stream::File::Mode::W, 4, 4000);
+		Stream::BufferOutput buffer(1024);
+		file < buffer;
+		for (std::uint32_t i{0}; i < count; ++i)
+			buffer << i;
+		buffer < nullptr;
+	}
+	assert(std::filesystem::file_size(path) == count * sizeof(std::uint32_t));
+
+	{
+		Stream::UringFile file(path, Stream::File::Mode::A, 3, 1000);
+		file << count;
+	}
+
+	{
+		Stream::UringFile file(path, Stream::File::Mode::R, 4, 4096);
+		Stream::BufferInput buffer(1000);
+		file > buffer;
+		std::uint32_t j;
+		for (std::uint32_t i{0}; i <= count; ++i) {
+			buffer >> j;
+			assert(i == j);
+		}
+		auto r{buffer.tryRead(&j, sizeof j)};
+		assert(!r && r.error() == std::make_error_code(std::errc::no_message_available));
+	}
+
+	{
+		Stream::UringFile file(path, Stream::File::Mode::RW, 2, 64);
+		std::uint32_t j;
+		file >> j;
+		assert(j == 0);
+		file << std::uint32_t{7};
+		file >> j;
+		assert(j == 2);
+	}
+
+	{
+		Stream::UringFile file(path, Stream::File::Mode::R, 2, 64);
+		std::uint32_t j[3];
+		file.read(j, sizeof j);
+		assert(j[0] == 0 && j[1] == 7 && j[2] == 2);
+	}
+
+	std::filesystem::remove(path);
+
+	if (std::filesystem::exists("/dev/full")) { // a failed block keeps failing the writes after it
+		Stream::UringFile full("/dev/full", Stream::File::Mode::W, 2, 64);
+		std::byte const block[64]{};
+		full.write(block, sizeof block);
+		for (int i{0}; i < 2; ++i)
+			try {
+				full << nullptr;
+				assert(false);
+			} catch (Stream::Output::Exception const& exc) {
+				assert((exc.code() == std::make_error_code(std::errc::no_space_on_device)));
+			}
+		auto r{full.tryWrite(block, sizeof block)};
+		assert(!r && r.error() == std::make_error_code(std::errc::no_space_on_device));
+	}
+	return 0;
+}
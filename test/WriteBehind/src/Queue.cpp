@@ -0,0 +1,117 @@
+#include <Stream/WriteBehind.hpp>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <poll.h>
+#include <string>
+#include <unistd.h>
+#include <thread>
+
+/**
+ * In-memory sink that takes its time and fails once it holds a given number of bytes
+ */
+class Memory : public Stream::Output {
+	std::size_t mLimit;
+
+	std::size_t
+	writeBytes(std::byte const* src, std::size_t size) override
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds{50});
+		if (data.size() + size > mLimit)
+			throw Exception{std::make_error_code(std::errc::no_space_on_device)};
+		data.append(reinterpret_cast<char const*>(src), size);
+		return size;
+	}
+
+public:
+
+	std::string data;
+
+	explicit
+	Memory(std::size_t limit = -1) noexcept
+			: mLimit{limit}
+	{}
+
+};
+
+/**
+ * Sink waiting on a descriptor that never becomes ready
+ */
+class Stuck : public Stream::Output {
+	int mPipe[2];
+
+	std::size_t
+	writeBytes(std::byte const*, std::size_t) override
+	{ return 0; }
+
+	std::error_code
+	waitWritable(unsigned) noexcept override
+	{ return Stream::Poll(mPipe[0], POLLIN); }
+
+public:
+
+	Stuck() noexcept
+	{ assert(::pipe(mPipe) == 0); }
+
+	~Stuck()
+	{
+		::close(mPipe[0]);
+		::close(mPipe[1]);
+	}
+
+};
+
+int main()
+{
+	std::string expected;
+	for (std::uint32_t i{0}; i < 20'000; ++i)
+		expected.append(reinterpret_cast<char const*>(&i), sizeof(i));
+
+	for (std::size_t depth : {2, 5}) {
+		Memory memory;
+		{
+			Stream::WriteBehindOutput output(100, depth);
+			assert(output.getDepth() == depth);
+			memory < output;
+			for (std::uint32_t i{0}; i < 10'000; ++i)
+				output << i;
+			output << nullptr; // everything queued is written
+			assert(memory.data == expected.substr(0, memory.data.size()) && memory.data.size() == 40'000);
+
+			output.write(expected.data() + 40'000, 40'000); // larger than a block
+			for (std::uint32_t i{0}; i < 100; ++i)
+				output << i;
+		} // destroying writes the rest
+		assert(memory.data.substr(0, 80'000) == expected);
+		assert(memory.data.size() == 80'400);
+	}
+
+	{ // the error of the sink is thrown on the producer thread
+		Memory memory{1000};
+		Stream::WriteBehindOutput output(100);
+		memory < output;
+		try {
+			for (std::uint32_t i{0}; i < 20'000; ++i)
+				output << i;
+			assert(false);
+		} catch (Stream::Output::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::no_space_on_device)));
+		}
+		assert(memory.data == expected.substr(0, 1000));
+
+		try {
+			output << nullptr;
+			assert(false);
+		} catch (Stream::Output::Exception const& exc) {
+			assert((exc.code() == std::make_error_code(std::errc::no_space_on_device)));
+		}
+	}
+
+	{ // destroyed while the thread waits for the sink
+		Stuck stuck;
+		Stream::WriteBehindOutput output(100);
+		stuck < output;
+		output.write(expected.data(), 300);
+	}
+	return 0;
+}